@@ -810,153 +810,174 @@ namespace witness {
 
   case 20: // clause_definition: CLAUSE identifier_expr EQUALS expression SEMICOLON
 #line 110 "src/parser.ypp"
-                                                       { yylhs.value.as < Statement* > () = new ClauseDefinition(std::unique_ptr<Identifier>(yystack_[3].value.as < Identifier* > ()), std::unique_ptr<Expression>(yystack_[1].value.as < Expression* > ())); }
-#line 815 "build/parser.tab.cpp"
+                                                       {
+        auto clause = new ClauseDefinition(std::unique_ptr<Identifier>(yystack_[3].value.as < Identifier* > ()), std::unique_ptr<Expression>(yystack_[1].value.as < Expression* > ()));
+        clause->line = yystack_[4].location.end.line; // The lexer only steps locations once per call, so begin can lag behind
+        clause->column = yystack_[4].location.end.column;
+        yylhs.value.as < Statement* > () = clause;
+    }
+#line 820 "build/parser.tab.cpp"
+    break;
+
+  case 21: // clause_definition: CLAUSE identifier_expr LPAREN IDENTIFIER RPAREN EQUALS expression SEMICOLON
+#line 116 "src/parser.ypp"
+                                                                                  {
+        auto clause = new ClauseDefinition(std::unique_ptr<Identifier>(yystack_[6].value.as < Identifier* > ()), std::unique_ptr<Expression>(yystack_[1].value.as < Expression* > ()));
+        clause->line = yystack_[7].location.end.line; // The lexer only steps locations once per call, so begin can lag behind
+        clause->column = yystack_[7].location.end.column;
+        if (yystack_[4].value.as < std::string > ().empty() || yystack_[4].value.as < std::string > ().size() > 15 || yystack_[4].value.as < std::string > ().find_first_not_of("0123456789") != std::string::npos || std::stoll(yystack_[4].value.as < std::string > ()) == 0) {
+            driver.error(yystack_[4].location, "clause weight must be a positive integer, got '" + yystack_[4].value.as < std::string > () + "'");
+        } else {
+            clause->weight = std::stoll(yystack_[4].value.as < std::string > ());
+        }
+        yylhs.value.as < Statement* > () = clause;
+    }
+#line 836 "build/parser.tab.cpp"
     break;
 
-  case 21: // clause_definition: CLAUSE identifier_expr EQUALS error SEMICOLON
-#line 111 "src/parser.ypp"
+  case 22: // clause_definition: CLAUSE identifier_expr EQUALS error SEMICOLON
+#line 127 "src/parser.ypp"
                                                     { 
         std::cerr << "Error recovery: Invalid clause definition for " << yystack_[3].value.as < Identifier* > ()->name << std::endl;
         yylhs.value.as < Statement* > () = new ClauseDefinition(std::unique_ptr<Identifier>(yystack_[3].value.as < Identifier* > ()), std::make_unique<Identifier>("error_recovery")); 
     }
-#line 824 "build/parser.tab.cpp"
+#line 845 "build/parser.tab.cpp"
     break;
 
-  case 22: // expression: identifier_expr
-#line 118 "src/parser.ypp"
+  case 23: // expression: identifier_expr
+#line 134 "src/parser.ypp"
                                     { yylhs.value.as < Expression* > () = yystack_[0].value.as < Identifier* > (); }
-#line 830 "build/parser.tab.cpp"
+#line 851 "build/parser.tab.cpp"
     break;
 
-  case 23: // expression: STRING_LITERAL
-#line 119 "src/parser.ypp"
+  case 24: // expression: STRING_LITERAL
+#line 135 "src/parser.ypp"
                                     { yylhs.value.as < Expression* > () = new StringLiteral(yystack_[0].value.as < std::string > ()); }
-#line 836 "build/parser.tab.cpp"
+#line 857 "build/parser.tab.cpp"
     break;
 
-  case 24: // expression: function_call
-#line 120 "src/parser.ypp"
+  case 25: // expression: function_call
+#line 136 "src/parser.ypp"
                                     { yylhs.value.as < Expression* > () = yystack_[0].value.as < Expression* > (); }
-#line 842 "build/parser.tab.cpp"
+#line 863 "build/parser.tab.cpp"
     break;
 
-  case 25: // expression: expression AND expression
-#line 121 "src/parser.ypp"
+  case 26: // expression: expression AND expression
+#line 137 "src/parser.ypp"
                                         { yylhs.value.as < Expression* > () = new BinaryOpExpression("AND", std::unique_ptr<Expression>(yystack_[2].value.as < Expression* > ()), std::unique_ptr<Expression>(yystack_[0].value.as < Expression* > ())); }
-#line 848 "build/parser.tab.cpp"
+#line 869 "build/parser.tab.cpp"
     break;
 
-  case 26: // expression: expression OR expression
-#line 122 "src/parser.ypp"
+  case 27: // expression: expression OR expression
+#line 138 "src/parser.ypp"
                                         { yylhs.value.as < Expression* > () = new BinaryOpExpression("OR", std::unique_ptr<Expression>(yystack_[2].value.as < Expression* > ()), std::unique_ptr<Expression>(yystack_[0].value.as < Expression* > ())); }
-#line 854 "build/parser.tab.cpp"
+#line 875 "build/parser.tab.cpp"
     break;
 
-  case 27: // expression: expression XOR expression
-#line 123 "src/parser.ypp"
+  case 28: // expression: expression XOR expression
+#line 139 "src/parser.ypp"
                                         { yylhs.value.as < Expression* > () = new BinaryOpExpression("XOR", std::unique_ptr<Expression>(yystack_[2].value.as < Expression* > ()), std::unique_ptr<Expression>(yystack_[0].value.as < Expression* > ())); }
-#line 860 "build/parser.tab.cpp"
+#line 881 "build/parser.tab.cpp"
     break;
 
-  case 28: // expression: expression IMPLIES expression
-#line 124 "src/parser.ypp"
+  case 29: // expression: expression IMPLIES expression
+#line 140 "src/parser.ypp"
                                         { yylhs.value.as < Expression* > () = new BinaryOpExpression("IMPLIES", std::unique_ptr<Expression>(yystack_[2].value.as < Expression* > ()), std::unique_ptr<Expression>(yystack_[0].value.as < Expression* > ())); }
-#line 866 "build/parser.tab.cpp"
+#line 887 "build/parser.tab.cpp"
     break;
 
-  case 29: // expression: expression EQUIV expression
-#line 125 "src/parser.ypp"
+  case 30: // expression: expression EQUIV expression
+#line 141 "src/parser.ypp"
                                         { yylhs.value.as < Expression* > () = new BinaryOpExpression("EQUIV", std::unique_ptr<Expression>(yystack_[2].value.as < Expression* > ()), std::unique_ptr<Expression>(yystack_[0].value.as < Expression* > ())); }
-#line 872 "build/parser.tab.cpp"
+#line 893 "build/parser.tab.cpp"
     break;
 
-  case 30: // expression: NOT expression
-#line 126 "src/parser.ypp"
+  case 31: // expression: NOT expression
+#line 142 "src/parser.ypp"
                                         { yylhs.value.as < Expression* > () = new UnaryOpExpression("NOT", std::unique_ptr<Expression>(yystack_[0].value.as < Expression* > ())); }
-#line 878 "build/parser.tab.cpp"
+#line 899 "build/parser.tab.cpp"
     break;
 
-  case 31: // expression: LPAREN expression RPAREN
-#line 127 "src/parser.ypp"
+  case 32: // expression: LPAREN expression RPAREN
+#line 143 "src/parser.ypp"
                                         { yylhs.value.as < Expression* > () = yystack_[1].value.as < Expression* > (); }
-#line 884 "build/parser.tab.cpp"
+#line 905 "build/parser.tab.cpp"
     break;
 
-  case 32: // expression: LPAREN error RPAREN
-#line 128 "src/parser.ypp"
+  case 33: // expression: LPAREN error RPAREN
+#line 144 "src/parser.ypp"
                                         { 
         std::cerr << "Error recovery: Invalid expression in parentheses" << std::endl;
         yylhs.value.as < Expression* > () = new Identifier("error_recovery"); 
     }
-#line 893 "build/parser.tab.cpp"
+#line 914 "build/parser.tab.cpp"
     break;
 
-  case 33: // function_call: identifier_expr LPAREN opt_expression_list RPAREN
-#line 135 "src/parser.ypp"
+  case 34: // function_call: identifier_expr LPAREN opt_expression_list RPAREN
+#line 151 "src/parser.ypp"
                                                       { yylhs.value.as < Expression* > () = new FunctionCallExpression(std::unique_ptr<Identifier>(yystack_[3].value.as < Identifier* > ()), std::unique_ptr<ExpressionList>(yystack_[1].value.as < ExpressionList* > ())); }
-#line 899 "build/parser.tab.cpp"
+#line 920 "build/parser.tab.cpp"
     break;
 
-  case 34: // function_call: identifier_expr LPAREN error RPAREN
-#line 136 "src/parser.ypp"
+  case 35: // function_call: identifier_expr LPAREN error RPAREN
+#line 152 "src/parser.ypp"
                                           { 
         std::cerr << "Error recovery: Invalid function call arguments for " << yystack_[3].value.as < Identifier* > ()->name << std::endl;
         yylhs.value.as < Expression* > () = new FunctionCallExpression(std::unique_ptr<Identifier>(yystack_[3].value.as < Identifier* > ()), std::make_unique<ExpressionList>()); 
     }
-#line 908 "build/parser.tab.cpp"
+#line 929 "build/parser.tab.cpp"
     break;
 
-  case 35: // function_call: identifier_expr LPAREN opt_expression_list error
-#line 140 "src/parser.ypp"
+  case 36: // function_call: identifier_expr LPAREN opt_expression_list error
+#line 156 "src/parser.ypp"
                                                        { 
         std::cerr << "Error recovery: Missing closing parenthesis for function " << yystack_[3].value.as < Identifier* > ()->name << std::endl;
         yylhs.value.as < Expression* > () = new FunctionCallExpression(std::unique_ptr<Identifier>(yystack_[3].value.as < Identifier* > ()), std::unique_ptr<ExpressionList>(yystack_[1].value.as < ExpressionList* > ())); 
     }
-#line 917 "build/parser.tab.cpp"
+#line 938 "build/parser.tab.cpp"
     break;
 
-  case 36: // opt_expression_list: %empty
-#line 147 "src/parser.ypp"
+  case 37: // opt_expression_list: %empty
+#line 163 "src/parser.ypp"
                       { yylhs.value.as < ExpressionList* > () = new ExpressionList(); }
-#line 923 "build/parser.tab.cpp"
+#line 944 "build/parser.tab.cpp"
     break;
 
-  case 37: // opt_expression_list: expression_list
-#line 148 "src/parser.ypp"
+  case 38: // opt_expression_list: expression_list
+#line 164 "src/parser.ypp"
                       { yylhs.value.as < ExpressionList* > () = yystack_[0].value.as < ExpressionList* > (); }
-#line 929 "build/parser.tab.cpp"
+#line 950 "build/parser.tab.cpp"
     break;
 
-  case 38: // identifier_expr: IDENTIFIER
-#line 152 "src/parser.ypp"
+  case 39: // identifier_expr: IDENTIFIER
+#line 168 "src/parser.ypp"
                { yylhs.value.as < Identifier* > () = new Identifier(yystack_[0].value.as < std::string > ()); }
-#line 935 "build/parser.tab.cpp"
+#line 956 "build/parser.tab.cpp"
     break;
 
-  case 39: // expression_list: expression
-#line 156 "src/parser.ypp"
+  case 40: // expression_list: expression
+#line 172 "src/parser.ypp"
                { yylhs.value.as < ExpressionList* > () = new ExpressionList(); yylhs.value.as < ExpressionList* > ()->addExpression(std::unique_ptr<Expression>(yystack_[0].value.as < Expression* > ())); }
-#line 941 "build/parser.tab.cpp"
+#line 962 "build/parser.tab.cpp"
     break;
 
-  case 40: // expression_list: expression_list COMMA expression
-#line 157 "src/parser.ypp"
+  case 41: // expression_list: expression_list COMMA expression
+#line 173 "src/parser.ypp"
                                        { yystack_[2].value.as < ExpressionList* > ()->addExpression(std::unique_ptr<Expression>(yystack_[0].value.as < Expression* > ())); yylhs.value.as < ExpressionList* > () = yystack_[2].value.as < ExpressionList* > (); }
-#line 947 "build/parser.tab.cpp"
+#line 968 "build/parser.tab.cpp"
     break;
 
-  case 41: // expression_list: expression_list COMMA error
-#line 158 "src/parser.ypp"
+  case 42: // expression_list: expression_list COMMA error
+#line 174 "src/parser.ypp"
                                   { 
         std::cerr << "Error recovery: Invalid expression in list" << std::endl;
         yylhs.value.as < ExpressionList* > () = yystack_[2].value.as < ExpressionList* > (); 
     }
-#line 956 "build/parser.tab.cpp"
+#line 977 "build/parser.tab.cpp"
     break;
 
 
-#line 960 "build/parser.tab.cpp"
+#line 981 "build/parser.tab.cpp"
 
             default:
               break;
@@ -1151,18 +1172,19 @@ namespace witness {
 
   const signed char Parser::yypact_ninf_ = -26;
 
-  const signed char Parser::yytable_ninf_ = -37;
+  const signed char Parser::yytable_ninf_ = -38;
 
   const signed char
   Parser::yypact_[] =
   {
-     -26,     1,    69,   -26,    -2,   -26,   -26,   -26,   -26,   -26,
-     -26,   -26,     4,     4,   -26,     4,   -26,   -26,   -26,   -26,
-     -26,     8,    24,    26,     9,    13,    34,     6,   -26,    38,
-      45,    82,   -26,    19,    66,    48,    70,    51,    98,   -26,
-       7,    75,   -26,    45,    45,    45,    45,    45,     5,   -26,
-      42,   -26,   -26,   -26,   -26,   -26,   -26,   -26,   -26,   -26,
-      82,   -26,    25,    22,    44,   -26,    82,   -26,   -26,   -26
+     -26,     9,    72,   -26,     2,   -26,   -26,   -26,   -26,   -26,
+     -26,   -26,    30,    30,   -26,    30,   -26,   -26,   -26,   -26,
+     -26,     6,    10,    28,    11,    15,    39,    36,    42,   -26,
+      40,    48,    78,   -26,    29,    -4,    50,    73,    38,    53,
+      59,   -26,    52,    88,   -26,    48,    48,    48,    48,    48,
+       7,   -26,    45,   -26,   -26,    55,   -26,   -26,   -26,   -26,
+     -26,   -26,   -26,    78,   -26,    54,     3,    61,   -26,    78,
+      48,   -26,   -26,   -26,    83,   -26
   };
 
   const signed char
@@ -1170,57 +1192,60 @@ namespace witness {
   {
        3,     0,     0,     1,     0,     8,    10,    11,    12,    13,
       14,    15,     0,     0,     4,     0,     5,     6,     7,     9,
-      38,     0,     0,     0,     0,     0,     0,     0,    23,     0,
-       0,    39,    24,    22,     0,     0,     0,     0,     0,    19,
-       0,     0,    30,     0,     0,     0,     0,     0,     0,    18,
-       0,    21,    20,    17,    16,    32,    31,    25,    26,    27,
-      28,    29,     0,     0,    37,    41,    40,    34,    35,    33
+      39,     0,     0,     0,     0,     0,     0,     0,     0,    24,
+       0,     0,    40,    25,    23,     0,     0,     0,     0,     0,
+       0,    19,     0,     0,    31,     0,     0,     0,     0,     0,
+       0,    18,     0,    22,    20,     0,    17,    16,    33,    32,
+      26,    27,    28,    29,    30,     0,     0,    38,    42,    41,
+       0,    35,    36,    34,     0,    21
   };
 
   const signed char
   Parser::yypgoto_[] =
   {
      -26,   -26,   -26,   -26,   -26,   -26,   -26,   -26,   -25,   -26,
-     -26,    39,   -24
+     -26,    41,   -24
   };
 
   const signed char
   Parser::yydefgoto_[] =
   {
-       0,     1,     2,    14,    15,    16,    17,    18,    31,    32,
-      63,    33,    34
+       0,     1,     2,    14,    15,    16,    17,    18,    32,    33,
+      66,    34,    35
   };
 
   const signed char
   Parser::yytable_[] =
   {
-      36,     3,    38,    19,    41,    42,    62,    20,    20,    28,
-      27,    39,    20,    28,    35,    24,    20,    28,    57,    58,
-      59,    60,    61,    68,    64,    66,    29,   -36,    30,    55,
-      29,    25,    30,    26,    29,    37,    30,    20,    28,    40,
-      48,    20,    28,    65,    69,    20,    28,    67,    20,    28,
-      50,    21,    22,    51,    23,    29,    53,    30,     0,    29,
-       0,    30,     0,    29,     0,    30,    29,     0,    30,    -2,
-       4,    49,    50,     0,     5,    52,     0,     6,     7,     8,
-       9,    10,    11,    12,    13,     0,    43,    44,    45,    46,
-      47,    43,    44,    45,    46,    47,     0,    56,    43,    44,
-      45,    46,    47,    54,    50
+      37,    51,    52,    40,    72,    43,    44,    19,    65,     3,
+      20,    29,    28,    24,    20,    29,    36,    25,    20,    29,
+      60,    61,    62,    63,    64,    73,    67,    69,    30,   -37,
+      31,    26,    30,    20,    31,    27,    30,    39,    31,    20,
+      29,    42,    38,    20,    29,    74,    68,    41,    20,    29,
+      50,    20,    29,    21,    22,    53,    23,    30,    56,    31,
+      55,    30,    70,    31,    57,    52,    30,    52,    31,    30,
+       0,    31,    -2,     4,    58,     0,    71,     5,    54,     0,
+       6,     7,     8,     9,    10,    11,    12,    13,    75,    45,
+      46,    47,    48,    49,    45,    46,    47,    48,    49,    45,
+      46,    47,    48,    49,    45,    46,    47,    48,    49,     0,
+      59
   };
 
   const signed char
   Parser::yycheck_[] =
   {
-      25,     0,    26,     5,    29,    30,     1,     3,     3,     4,
-       1,     5,     3,     4,     1,     7,     3,     4,    43,    44,
-      45,    46,    47,     1,    48,    50,    21,    22,    23,    22,
-      21,     7,    23,     7,    21,     1,    23,     3,     4,     1,
-      21,     3,     4,     1,    22,     3,     4,    22,     3,     4,
-       6,    12,    13,     5,    15,    21,     5,    23,    -1,    21,
-      -1,    23,    -1,    21,    -1,    23,    21,    -1,    23,     0,
-       1,     5,     6,    -1,     5,     5,    -1,     8,     9,    10,
-      11,    12,    13,    14,    15,    -1,    16,    17,    18,    19,
-      20,    16,    17,    18,    19,    20,    -1,    22,    16,    17,
-      18,    19,    20,     5,     6
+      25,     5,     6,    27,     1,    30,    31,     5,     1,     0,
+       3,     4,     1,     7,     3,     4,     1,     7,     3,     4,
+      45,    46,    47,    48,    49,    22,    50,    52,    21,    22,
+      23,    21,    21,     3,    23,     7,    21,     1,    23,     3,
+       4,     1,     3,     3,     4,    70,     1,     5,     3,     4,
+      21,     3,     4,    12,    13,     5,    15,    21,     5,    23,
+      22,    21,     7,    23,     5,     6,    21,     6,    23,    21,
+      -1,    23,     0,     1,    22,    -1,    22,     5,     5,    -1,
+       8,     9,    10,    11,    12,    13,    14,    15,     5,    16,
+      17,    18,    19,    20,    16,    17,    18,    19,    20,    16,
+      17,    18,    19,    20,    16,    17,    18,    19,    20,    -1,
+      22
   };
 
   const signed char
@@ -1228,11 +1253,12 @@ namespace witness {
   {
        0,    25,    26,     0,     1,     5,     8,     9,    10,    11,
       12,    13,    14,    15,    27,    28,    29,    30,    31,     5,
-       3,    35,    35,    35,     7,     7,     7,     1,     4,    21,
-      23,    32,    33,    35,    36,     1,    32,     1,    36,     5,
-       1,    32,    32,    16,    17,    18,    19,    20,    21,     5,
-       6,     5,     5,     5,     5,    22,    22,    32,    32,    32,
-      32,    32,     1,    34,    36,     1,    32,    22,     1,    22
+       3,    35,    35,    35,     7,     7,    21,     7,     1,     4,
+      21,    23,    32,    33,    35,    36,     1,    32,     3,     1,
+      36,     5,     1,    32,    32,    16,    17,    18,    19,    20,
+      21,     5,     6,     5,     5,    22,     5,     5,    22,    22,
+      32,    32,    32,    32,    32,     1,    34,    36,     1,    32,
+       7,    22,     1,    22,    32,     5
   };
 
   const signed char
@@ -1240,9 +1266,9 @@ namespace witness {
   {
        0,    24,    25,    26,    26,    27,    27,    27,    27,    27,
       28,    28,    28,    28,    28,    28,    29,    29,    30,    30,
-      31,    31,    32,    32,    32,    32,    32,    32,    32,    32,
-      32,    32,    32,    33,    33,    33,    34,    34,    35,    36,
-      36,    36
+      31,    31,    31,    32,    32,    32,    32,    32,    32,    32,
+      32,    32,    32,    32,    33,    33,    33,    34,    34,    35,
+      36,    36,    36
   };
 
   const signed char
@@ -1250,9 +1276,9 @@ namespace witness {
   {
        0,     2,     1,     0,     2,     1,     1,     1,     1,     2,
        1,     1,     1,     1,     1,     1,     5,     5,     5,     5,
-       5,     5,     1,     1,     1,     3,     3,     3,     3,     3,
-       2,     3,     3,     4,     4,     4,     0,     1,     1,     1,
-       3,     3
+       5,     8,     5,     1,     1,     1,     3,     3,     3,     3,
+       3,     2,     3,     3,     4,     4,     4,     0,     1,     1,
+       1,     3,     3
   };
 
 
@@ -1279,9 +1305,9 @@ namespace witness {
   {
        0,    65,    65,    69,    70,    74,    75,    76,    77,    78,
       85,    86,    87,    88,    89,    90,    94,    95,   102,   103,
-     110,   111,   118,   119,   120,   121,   122,   123,   124,   125,
-     126,   127,   128,   135,   136,   140,   147,   148,   152,   156,
-     157,   158
+     110,   116,   127,   134,   135,   136,   137,   138,   139,   140,
+     141,   142,   143,   144,   151,   152,   156,   163,   164,   168,
+     172,   173,   174
   };
 
   void
@@ -1314,9 +1340,9 @@ namespace witness {
 
 #line 25 "src/parser.ypp"
 } // witness
-#line 1318 "build/parser.tab.cpp"
+#line 1344 "build/parser.tab.cpp"
 
-#line 164 "src/parser.ypp"
+#line 180 "src/parser.ypp"
 
 
 // Error reporting function
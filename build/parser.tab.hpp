@@ -1586,7 +1586,7 @@ switch (yykind)
     /// Constants.
     enum
     {
-      yylast_ = 104,     ///< Last index in yytable_.
+      yylast_ = 110,     ///< Last index in yytable_.
       yynnts_ = 13,  ///< Number of nonterminal symbols.
       yyfinal_ = 3 ///< Termination state number.
     };
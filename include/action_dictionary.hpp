@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace witness {
+
+// A keyword of an action dictionary and the type it implies
+struct ActionPattern {
+    std::string pattern;      // Matched case-insensitively anywhere in an action literal
+    std::string type;         // "service" or "object"
+    std::string constraint;   // "positive"/"negative" for services, "movable"/"non_movable" for objects
+};
+
+// Infers the type an action literal refers to from the keywords it contains.
+// Every keyword is compiled into one Aho-Corasick automaton, so a literal is
+// classified in a single pass over its characters however many keywords are
+// loaded. When keywords of several categories match, positive services win,
+// then negative services, movable objects and non-movable objects; a literal
+// matching none refers to a movable object. Results are memoized per literal.
+class ActionDictionary {
+public:
+    // Starts with the built-in English keywords
+    ActionDictionary();
+
+    void addPatterns(const std::vector<ActionPattern>& patterns);
+
+    // (type, constraint) of the object or service an action literal refers to
+    std::pair<std::string, std::string> infer(const std::string& action);
+
+    // Reads lines "TYPE CONSTRAINT: keyword, keyword, ..."; '#' and '//' start comments
+    static bool parse(std::istream& input, std::vector<ActionPattern>& patterns, std::string& error);
+
+private:
+    struct State {
+        std::array<int, 256> next;   // Full transition function once built
+        int category;                // Highest-priority category ending here or at a suffix
+    };
+
+    std::vector<std::pair<std::string, int>> keywords;   // Lowercased keyword, category
+    std::vector<State> states;
+    bool built = false;
+    std::unordered_map<std::string, int> memo;            // Literal -> category
+
+    void add(const std::string& keyword, int category);
+    void build();
+};
+
+} // namespace witness
@@ -155,6 +155,9 @@ class ClauseDefinition : public Statement {
 public:
     std::unique_ptr<Identifier> name;
     std::unique_ptr<Expression> expression;
+    long long weight = 1;  // Priority annotation: clause name(weight) = ...
+    int line = 0;          // Source position of the 'clause' keyword (0 when unknown)
+    int column = 0;
 
     ClauseDefinition(std::unique_ptr<Identifier> name, std::unique_ptr<Expression> expr)
         : name(std::move(name)), expression(std::move(expr)) {}
@@ -162,6 +165,9 @@ public:
     void print(std::ostream& os, int indent = 0) const override {
         os << std::string(indent, ' ') << "ClauseDefinition: ";
         name->print(os);
+        if (weight != 1) {
+            os << "(" << weight << ")";
+        }
         os << " = ";
         expression->print(os, indent + 2);
         os << ";";
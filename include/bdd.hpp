@@ -0,0 +1,88 @@
+#pragma once
+
+#include "ast.hpp"
+#include "big_count.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace witness {
+
+// Reduced ordered binary decision diagram over variables 0..numVars()-1,
+// variable 0 at the top. Nodes are shared and hash-consed, so equal
+// functions get equal node handles and counting is linear in the diagram.
+class Bdd {
+public:
+    using Node = int;
+    static constexpr Node False = 0;
+    static constexpr Node True = 1;
+
+    // Compilation gives up (and overflowed() turns true) past max_nodes
+    explicit Bdd(int num_vars, size_t max_nodes = 2000000);
+
+    int numVars() const { return num_vars; }
+    size_t size() const { return nodes.size(); }
+    bool overflowed() const { return overflow; }
+
+    Node variable(int var);
+    Node negate(Node f);
+    Node conjoin(Node f, Node g);
+    Node disjoin(Node f, Node g);
+    Node exclusiveOr(Node f, Node g);
+
+    // Existentially quantify every variable from first_level down
+    Node existsFrom(Node f, int first_level);
+
+    // Compile a clause expression following SemanticAnalyzer::evalExpr;
+    // var_of maps asset names to BDD variables, unknown assets are false
+    Node compile(Expression* expr, const std::unordered_map<std::string, int>& var_of);
+
+    // Node structure; terminals have level numVars()
+    int level(Node f) const { return nodes[f].var; }
+    Node low(Node f) const { return nodes[f].low; }
+    Node high(Node f) const { return nodes[f].high; }
+
+    // Number of assignments to all variables satisfying f
+    BigCount countModels(Node f) const;
+
+    // Models of f in which each variable is true, for every variable in one
+    // bottom-up counting pass and one top-down pass over the diagram
+    std::vector<BigCount> marginalCounts(Node f) const;
+
+    // Same with independent variable probabilities: fills the probability of f
+    // and returns P(f and variable true) for every variable
+    std::vector<double> weightedMarginals(Node f, const std::vector<double>& probability, double& total) const;
+
+private:
+    struct NodeData {
+        int var;
+        Node low;
+        Node high;
+    };
+
+    struct PairHash {
+        size_t operator()(const std::pair<long long, int>& key) const {
+            return std::hash<long long>()(key.first * 1000003LL + key.second);
+        }
+    };
+
+    enum class Op { And, Or, Xor };
+
+    int num_vars;
+    size_t max_nodes;
+    bool overflow;
+    std::vector<NodeData> nodes;
+    std::unordered_map<std::pair<long long, int>, Node, PairHash> unique;
+    std::unordered_map<std::pair<long long, int>, Node, PairHash> cache;
+
+    Node make(int var, Node low, Node high);
+    Node apply(Op op, Node f, Node g);
+    Node compileExpr(Expression* expr, const std::unordered_map<std::string, int>& var_of,
+                     std::unordered_map<Expression*, Node>& memo);
+
+    // Nodes reachable from f, children before parents
+    std::vector<Node> topologicalOrder(Node f) const;
+};
+
+} // namespace witness
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace witness {
+
+// Unsigned arbitrary-precision integer for model counts, which overflow
+// 64 bits as soon as a block has more than 63 free assets.
+class BigCount {
+public:
+    BigCount(uint64_t value = 0);
+
+    bool isZero() const { return limbs.empty(); }
+
+    BigCount& operator+=(const BigCount& other);
+    BigCount& operator-=(const BigCount& other);    // Requires other <= *this
+    BigCount& operator<<=(unsigned bits);
+    BigCount operator+(const BigCount& other) const;
+    BigCount operator-(const BigCount& other) const;
+    BigCount operator*(const BigCount& other) const;
+    BigCount operator<<(unsigned bits) const;
+
+    bool operator<(const BigCount& other) const;
+    bool operator==(const BigCount& other) const { return limbs == other.limbs; }
+    bool operator!=(const BigCount& other) const { return limbs != other.limbs; }
+    bool operator<=(const BigCount& other) const { return !(other < *this); }
+
+    static BigCount power2(unsigned bits);
+
+    // Quotient by a small divisor, storing the remainder
+    BigCount divide(uint32_t divisor, uint32_t& remainder) const;
+
+    double toDouble() const;
+    std::string toString() const;
+
+private:
+    std::vector<uint32_t> limbs;   // Little-endian base 2^32, no leading zero limbs
+
+    void trim();
+};
+
+} // namespace witness
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ast.hpp"
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -13,6 +14,60 @@ struct ClauseInfo {
     std::vector<int> negative_literals;      // Asset IDs that must be false
     std::string expression;                  // Original expression string
     Expression* expr = nullptr;              // Pointer to the actual clause expression
+    long long weight = 1;                    // Priority used when relaxing unsatisfiable blocks
+    int line = 0;                            // Source position of the ClauseDefinition (0 when unknown)
+    int column = 0;
+};
+
+// Read-only view of a clause list, or of the clauses at the given indices, so
+// a cone of influence is solved in place instead of copied out of its block.
+// The view does not own the list or the indices; both must outlive it
+class ClauseView {
+public:
+    class const_iterator {
+    public:
+        const_iterator(const ClauseView* view, size_t pos) : view(view), pos(pos) {}
+        const ClauseInfo& operator*() const { return (*view)[pos]; }
+        const ClauseInfo* operator->() const { return &(*view)[pos]; }
+        const_iterator& operator++() { ++pos; return *this; }
+        bool operator==(const const_iterator& other) const { return pos == other.pos; }
+        bool operator!=(const const_iterator& other) const { return pos != other.pos; }
+
+    private:
+        const ClauseView* view;
+        size_t pos;
+    };
+
+    ClauseView(const std::vector<ClauseInfo>& clauses) : clauses(&clauses), indices(nullptr) {}
+    ClauseView(const std::vector<ClauseInfo>& clauses, const std::vector<size_t>& indices)
+        : clauses(&clauses), indices(&indices) {}
+
+    size_t size() const { return indices ? indices->size() : clauses->size(); }
+    bool empty() const { return size() == 0; }
+    const ClauseInfo& operator[](size_t i) const { return (*clauses)[indices ? (*indices)[i] : i]; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    // The viewed clauses as a list, for interfaces that take one: a whole list
+    // is returned as it is, a selection is copied into storage
+    const std::vector<ClauseInfo>& materialize(std::vector<ClauseInfo>& storage) const {
+        if (!indices) return *clauses;
+        storage.clear();
+        for (size_t i : *indices) {
+            storage.push_back((*clauses)[i]);
+        }
+        return storage;
+    }
+
+private:
+    const std::vector<ClauseInfo>* clauses;
+    const std::vector<size_t>* indices;
+};
+
+// Clauses checked together by one global() or litis() operation
+struct ClauseBlock {
+    std::string label;                       // e.g. "global() #1"
+    std::vector<ClauseInfo> clauses;
 };
 
 } // namespace witness 
\ No newline at end of file
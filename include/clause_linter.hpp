@@ -0,0 +1,37 @@
+#pragma once
+
+#include "clause_info.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace witness {
+
+// Findings of a redundancy pass over one clause block, as clause indices
+struct LintReport {
+    bool satisfiable = true;                 // Redundancy is vacuous in an unsatisfiable block
+    std::vector<size_t> tautologies;         // True in every assignment
+    std::vector<size_t> contradictions;      // False in every assignment
+    std::vector<size_t> redundant;           // Implied by the rest of the block
+    std::vector<size_t> removable;           // Redundant clauses that can all be dropped together
+};
+
+// Finds clauses that do not constrain their block. Every clause is encoded
+// once, guarded by a selector literal, on one incremental solver; the
+// per-clause checks are assumption calls run in parallel on solver copies.
+class ClauseLinter {
+public:
+    // asset_vars maps asset names to solver variables (normally asset_to_id)
+    explicit ClauseLinter(const std::unordered_map<std::string, int>& asset_vars);
+
+    LintReport lint(ClauseView clauses) const;
+
+    // Human-readable summary of a report
+    static std::string format(const LintReport& report, ClauseView clauses);
+
+private:
+    const std::unordered_map<std::string, int>& asset_vars;
+};
+
+} // namespace witness
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "ast.hpp"
+#include "sat_solver.hpp"
+#include <string>
+#include <unordered_map>
+
+namespace witness {
+
+// Tseitin encoder from clause expressions into a SatSolver.
+// The encoding follows SemanticAnalyzer::evalExpr exactly, so every engine
+// agrees with the exhaustive truth table on every assignment.
+class CnfEncoder {
+public:
+    // asset_vars maps asset names to solver variables (normally asset_to_id)
+    CnfEncoder(SatSolver& solver, const std::unordered_map<std::string, int>& asset_vars);
+
+    // Literal equivalent to the expression
+    int encode(Expression* expr);
+
+    // Assert the expression, optionally guarded by a selector literal (selector -> expr)
+    void addConstraint(Expression* expr, int selector = 0);
+
+    // Literal that is false in every model
+    int falseLiteral();
+
+private:
+    SatSolver& solver;
+    const std::unordered_map<std::string, int>& asset_vars;
+    std::unordered_map<Expression*, int> cache;
+    int false_lit;
+
+    int encodeAnd(int a, int b);
+    int encodeOr(int a, int b);
+    int encodeXor(int a, int b);
+};
+
+} // namespace witness
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace witness {
+
+// Formal-concept lattice over assets and their (subject, action, object)
+// components. Each attribute is a role and a value, e.g. subject=alice, and
+// stores the set of assets carrying it as a bitset. Every asset has one
+// attribute per role, so each concept intent is a subset of some asset's
+// three attributes and the lattice has at most 8 concepts per asset; it is
+// maintained incrementally as assets are registered.
+class ConceptLattice {
+public:
+    enum Role { Subject = 0, Action = 1, Object = 2 };
+
+    // Bitset over registration indices that stores only the words from its
+    // lowest set bit up, so an attribute first seen late stays short
+    struct Bits {
+        size_t first = 0;               // Word index of words[0]
+        std::vector<uint64_t> words;    // Missing words on either side are zero
+    };
+    using Attributes = std::vector<std::pair<Role, std::string>>;
+
+    struct Concept {
+        Bits extent;               // Assets, by registration index
+        std::vector<int> intent;   // Attribute IDs, sorted
+    };
+
+    // Register an asset with at least three components; later calls for the same name are ignored
+    void addAsset(const std::string& name, const std::vector<std::string>& components);
+
+    bool contains(const std::string& name) const { return asset_index.count(name) > 0; }
+    size_t assetCount() const { return asset_names.size(); }
+    size_t conceptCount() const { return concepts.size(); }
+
+    // Concept of the attributes two assets share; nullptr if either is unknown
+    const Concept* meet(const std::string& left, const std::string& right) const;
+
+    // Value of a role in a concept's intent, empty when the role is not shared
+    std::string roleValue(const Concept& concept, Role role) const;
+
+    // Assets carrying every given (role, value) attribute, by bitset intersection
+    std::vector<std::string> assetsWith(const Attributes& attributes) const;
+
+    // Reads "role=value,role=value" where each role is subject, action or object
+    static bool parseAttributes(const std::string& spec, Attributes& attributes, std::string& error);
+
+    std::vector<std::string> extentNames(const Bits& extent) const;
+
+private:
+    std::vector<std::string> asset_names;
+    std::unordered_map<std::string, size_t> asset_index;
+    std::vector<std::vector<int>> asset_intents;        // Sorted attribute IDs per asset
+    std::map<std::pair<int, std::string>, int> attribute_ids;
+    std::vector<std::pair<int, std::string>> attributes;
+    std::vector<Bits> attribute_extents;
+    std::map<std::vector<int>, Concept> concepts;       // Keyed by intent
+
+    Bits allAssets() const;
+    Bits extentOf(const std::vector<int>& intent) const;
+    static bool subsetOf(const Bits& a, const Bits& b);
+    // Extents grow only when a bit is set, so registering an asset leaves the others untouched
+    static void setBit(Bits& bits, size_t index);
+};
+
+} // namespace witness
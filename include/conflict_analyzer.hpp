@@ -3,31 +3,110 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <set>
 #include "clause_info.hpp"
+#include "sat_solver.hpp"
 
 namespace witness {
 
+// Cheapest way to restore satisfiability: the complement of a maximum-weight satisfiable subset
+struct Relaxation {
+    bool optimal = false;                   // False if the MaxSAT search did not finish
+    long long relaxed_weight = 0;           // Total weight of the relaxed clauses
+    long long total_weight = 0;             // Total weight of all analysed clauses
+    std::vector<size_t> relaxed;            // Indices of the relaxed clauses
+    std::vector<int> assignment;            // Signed asset IDs satisfying the remaining clauses
+};
+
+// MUSes and MCSes found by a budgeted MARCO enumeration, as clause indices
+struct ConflictEnumeration {
+    bool complete = false;                       // False if the budget ran out first
+    double elapsed_seconds = 0.0;
+    std::vector<std::vector<size_t>> muses;      // Minimal unsatisfiable subsets
+    std::vector<std::vector<size_t>> mcses;      // Minimal correction sets
+};
+
 class ConflictAnalyzer {
 public:
     ConflictAnalyzer();
     
-    // Find minimal conflicting set of clauses
+    // Wall-clock budget for enumerating every MUS and MCS after conflict reports (0 disables)
+    void setEnumerationBudget(double seconds);
+    double getEnumerationBudget() const;
+    
+    // Report the clause whose addition first makes the block unsatisfiable
+    void setLocalizeEarliest(bool enabled);
+    bool getLocalizeEarliest() const;
+    
+    // Find minimal conflicting set of clauses (descriptions of a MUS)
     std::vector<std::string> findMinimalConflictingSet(
         const std::vector<ClauseInfo>& clauses,
         const std::unordered_map<int, std::string>& asset_mapping);
     
-    // Generate human-readable conflict report
+    // Minimal unsatisfiable subset by deletion over selector literals on one
+    // incremental solver, with core refinement; returns clause indices in
+    // order, or nothing when the clauses are satisfiable
+    std::vector<size_t> findMinimalUnsatisfiableSubset(
+        const std::vector<ClauseInfo>& clauses,
+        const std::unordered_map<int, std::string>& asset_mapping);
+    
+    // Add the clauses to one incremental solver in order, solving after each;
+    // returns the index of the first clause that makes the prefix unsatisfiable,
+    // or clauses.size() when all of them are satisfiable together
+    size_t findEarliestConflict(
+        const std::vector<ClauseInfo>& clauses,
+        const std::unordered_map<int, std::string>& asset_mapping);
+    
+    // MARCO enumeration over the power set of the clauses: a map solver over one
+    // variable per clause proposes unexplored subsets, which are grown to a maximal
+    // satisfiable subset (whose complement is an MCS) or shrunk to a MUS and then
+    // blocked in the map. Stops when the map is exhausted or the budget runs out.
+    ConflictEnumeration enumerateConflicts(
+        const std::vector<ClauseInfo>& clauses,
+        const std::unordered_map<int, std::string>& asset_mapping,
+        double budget_seconds);
+    
+    // Weighted MaxSAT over the clauses, using ClauseInfo::weight as the priority
+    Relaxation findCheapestRelaxation(
+        const std::vector<ClauseInfo>& clauses,
+        const std::unordered_map<int, std::string>& asset_mapping);
+    
+    // Generate human-readable conflict report, including the cheapest relaxation of the clauses
     std::string generateConflictReport(
         const std::vector<std::string>& conflicting_clauses,
+        const std::vector<ClauseInfo>& clauses,
         const std::unordered_map<int, std::string>& asset_mapping);
 
 private:
-    // Analyze conflicts in binary operations
-    std::vector<std::string> analyzeBinaryOperationConflicts(
-        const ClauseInfo& clause,
-        const std::vector<ClauseInfo>& all_clauses,
+    double enumeration_budget;
+    bool localize_earliest;
+    
+    // Shrink an unsatisfiable set of clause indices to a MUS on a solver whose
+    // clauses are guarded by selectors; returns false if the solver was interrupted.
+    // With parallel set, the necessity checks run on worker copies of the solver.
+    static bool shrinkToMus(
+        SatSolver& solver,
+        const std::vector<int>& selectors,
+        std::vector<size_t> candidate,
+        std::vector<size_t>& mus,
+        bool parallel);
+    
+    // Solver variables for asset names (the inverse of asset_mapping)
+    static std::unordered_map<std::string, int> invertAssetMapping(
         const std::unordered_map<int, std::string>& asset_mapping);
     
+    // Encode each clause guarded by a fresh selector literal; returns the selectors in clause order
+    static std::vector<int> encodeWithSelectors(
+        SatSolver& solver,
+        const std::vector<ClauseInfo>& clauses,
+        const std::unordered_map<std::string, int>& asset_vars);
+    
+    // Asset IDs mentioned by an expression
+    static void collectAssets(
+        Expression* expr,
+        const std::unordered_map<std::string, int>& asset_vars,
+        std::set<int>& ids);
+    
     // Format clause description for reporting
     std::string formatClauseDescription(
         const ClauseInfo& clause,
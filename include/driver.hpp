@@ -4,6 +4,7 @@
 #include <string>
 #include <fstream>
 #include <memory>
+#include <vector>
 #include <iostream>
 #include "ast.hpp"
 #include "parser.tab.hpp"
@@ -37,6 +38,9 @@ public:
 
     // Get the parsed program
     Program* get_program() const;
+    
+    // Get the semantic analyzer, e.g. to read collected clause blocks
+    SemanticAnalyzer* get_analyzer() const;
 
     // Run semantic analysis
     void analyze();
@@ -47,6 +51,59 @@ public:
     // Solver mode management
     void setSolverMode(const std::string& mode);
     std::string getSolverMode() const;
+    
+    // Model reporting mode management
+    void setModelsMode(const std::string& mode);
+    std::string getModelsMode() const;
+    
+    // Page of models in truth table order; count 0 reports all
+    void setModelsPage(uint64_t offset, size_t count);
+    
+    // Optimization query management
+    void setOptimizeQuery(const std::string& query);
+    std::string getOptimizeQuery() const;
+    
+    // Conflict enumeration budget in seconds (0 disables)
+    void setConflictBudget(double seconds);
+    double getConflictBudget() const;
+    
+    // Earliest-conflict localization on unsatisfiable blocks
+    void setEarliestConflict(bool enabled);
+    bool getEarliestConflict() const;
+    
+    // Backbone reporting on satisfiable blocks
+    void setBackboneMode(bool enabled);
+    bool getBackboneMode() const;
+    
+    // Marginal model counts, with optional "name@p,..." asset likelihoods
+    void setMarginalsMode(bool enabled);
+    bool getMarginalsMode() const;
+    void setAssetLikelihoods(const std::string& spec);
+    
+    // Clause redundancy pass
+    void setLintRedundant(bool enabled);
+    bool getLintRedundant() const;
+    
+    // Per-clause model-count delta
+    void setClauseImpact(bool enabled);
+    bool getClauseImpact() const;
+    
+    // Contextual join discovery across all assets
+    void setSuggestJoins(bool enabled);
+    bool getSuggestJoins() const;
+    
+    // Per-subject projections at every global() block
+    void setPartiesMode(bool enabled);
+    bool getPartiesMode() const;
+    
+    // Keywords from --action-dictionary files for action type inference
+    void setActionDictionary(const std::vector<ActionPattern>& patterns);
+    
+    // litis() target sets checked against every global() block
+    void setLitisQueries(const std::vector<std::vector<std::string>>& queries);
+    
+    // Component queries over all assets of the program
+    void setAttributeQueries(const std::vector<ConceptLattice::Attributes>& queries);
 
     // Verbosity control
     void setVerbose(bool verbose);
@@ -65,9 +122,53 @@ private:
     // The semantic analyzer instance
     std::unique_ptr<SemanticAnalyzer> analyzer;
     
-    // Solver mode: "exhaustive" or "external"
+    // Solver mode: "exhaustive", "external", "sat", "auto" or "portfolio"
     std::string solverMode;
     
+    // Models mode: "all" or "minimal"
+    std::string modelsMode;
+    
+    // --models-page=OFFSET:COUNT
+    uint64_t modelsPageOffset;
+    size_t modelsPageCount;
+    
+    // Optimization query, e.g. "min:subject=arrendatario"; empty when disabled
+    std::string optimizeQuery;
+    
+    // Seconds allowed for MUS/MCS enumeration on unsatisfiable blocks; 0 when disabled
+    double conflictBudget;
+    
+    // Report the clause that first makes an unsatisfiable block inconsistent
+    bool earliestConflict;
+    
+    // Report assets with the same value in every model of a block
+    bool backboneMode;
+    
+    // Report per-asset model counts, weighted by the given likelihoods
+    bool marginalsMode;
+    std::string assetLikelihoods;
+    
+    // Report clauses that do not constrain their block
+    bool lintRedundant;
+    
+    // Rank clauses by how many models their removal adds
+    bool clauseImpact;
+    
+    // Report every valid contextual join between reciprocal assets
+    bool suggestJoins;
+    
+    // Project every global() block onto each subject
+    bool partiesMode;
+    
+    // Keywords from --action-dictionary files
+    std::vector<ActionPattern> actionPatterns;
+    
+    // Target sets from a --queries file
+    std::vector<std::vector<std::string>> litisQueries;
+    
+    // Component queries from --assets-with
+    std::vector<ConceptLattice::Attributes> attributeQueries;
+    
     // Verbosity flags
     bool verbose;
     bool quiet;
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace witness {
+
+// Truth table of a single clause over the assets it mentions
+struct ClauseTable {
+    std::vector<int> asset_ids;        // Sorted asset IDs mentioned by the clause
+    std::vector<uint32_t> models;      // Satisfying assignments, bit j = value of asset_ids[j]
+    bool complete = true;              // False when the arity exceeded the table limit
+};
+
+// Structural summary of a clause block used to predict solver cost
+struct BlockProfile {
+    int num_assets = 0;
+    int num_clauses = 0;
+    std::map<int, int> arity_histogram;   // arity -> number of clauses
+    int two_sat_clauses = 0;              // Clauses expressible as 2-CNF
+    int horn_clauses = 0;                 // Clauses expressible as Horn CNF
+    int xor_clauses = 0;                  // Clauses expressible as XOR constraints
+    int components = 0;                   // Connected components of the primal graph
+    int largest_component = 0;
+    int treewidth_estimate = 0;           // Min-degree elimination upper bound
+    double log2_models = 0.0;             // Independence estimate of log2(#models)
+    long long formula_size = 0;           // Total clause arity plus one per clause
+
+    bool isTwoSat() const { return two_sat_clauses == num_clauses; }
+    bool isHorn() const { return horn_clauses == num_clauses; }
+    bool isXor() const { return xor_clauses == num_clauses; }
+};
+
+// Predicted cost of running one engine on a block
+struct EngineEstimate {
+    std::string engine;
+    bool available = false;
+    double cost = 0.0;
+};
+
+// Picks the cheapest available engine for a clause block
+class EngineSelector {
+public:
+    // Largest clause arity for which a truth table is built
+    static constexpr int kMaxTableArity = 16;
+
+    BlockProfile profile(const std::vector<ClauseTable>& tables) const;
+    std::vector<EngineEstimate> estimate(const BlockProfile& profile, bool external_available) const;
+    EngineEstimate select(const BlockProfile& profile, bool external_available) const;
+
+    // One-line human-readable summary for verbose output
+    static std::string describe(const BlockProfile& profile);
+
+private:
+    // Schaefer class membership of a single clause
+    static bool isBijunctive(const ClauseTable& table);
+    static bool isHorn(const ClauseTable& table);
+    static bool isAffine(const ClauseTable& table);
+
+    static int estimateTreewidth(const std::vector<ClauseTable>& tables, const std::vector<int>& assets);
+};
+
+} // namespace witness
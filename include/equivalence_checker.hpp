@@ -0,0 +1,56 @@
+#pragma once
+
+#include "clause_info.hpp"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace witness {
+
+// One version of a contract: its clause blocks and the components of its assets
+struct ContractVersion {
+    std::string filename;
+    std::vector<ClauseBlock> blocks;
+    std::unordered_map<std::string, std::vector<std::string>> asset_components;   // Name -> (subject, action, object)
+};
+
+// Outcome of comparing two clause sets over the aligned assets
+struct EquivalenceResult {
+    bool old_in_new = false;                          // Every old outcome is admitted by the new version
+    bool new_in_old = false;                          // Every new outcome is admitted by the old version
+    std::vector<std::pair<std::string, bool>> only_old;   // Outcome admitted only by the old version
+    std::vector<std::pair<std::string, bool>> only_new;   // Outcome admitted only by the new version
+};
+
+// Decides equivalence and refinement between two contract versions.
+// Assets are aligned by name, then renamed assets by their component triple;
+// both clause sets are encoded into one miter solver and each direction of
+// containment is a single SAT call.
+class EquivalenceChecker {
+public:
+    EquivalenceChecker(const ContractVersion& old_version, const ContractVersion& new_version);
+
+    // How assets were matched, one line per noteworthy asset
+    const std::vector<std::string>& alignmentNotes() const { return notes; }
+
+    EquivalenceResult compare(const std::vector<ClauseInfo>& old_clauses,
+                              const std::vector<ClauseInfo>& new_clauses) const;
+
+    // "EQUIVALENT", "REFINEMENT", "RELAXATION" or "DIFFERENT" with an explanation
+    static std::string describe(const EquivalenceResult& result);
+
+    // All clauses of a version, conjoined across its blocks
+    static std::vector<ClauseInfo> allClauses(const ContractVersion& version);
+
+private:
+    std::unordered_map<std::string, int> old_vars;   // Asset name in the old version -> shared variable
+    std::unordered_map<std::string, int> new_vars;
+    std::vector<std::string> var_names;              // Display name per variable (index = variable - 1)
+    std::vector<std::string> notes;
+
+    int addVariable(const std::string& display_name);
+    static void collectNames(Expression* expr, std::vector<std::string>& names);
+};
+
+} // namespace witness
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace witness {
+
+// Action labels of join assets. A join's action is its operands' actions
+// joined with '_', prefixed with the join type for contextual joins, so a
+// chain of n joins spelled out holds O(n^2) characters. Each label is
+// interned instead as a node over the two labels it combines, fingerprinted
+// with a polynomial hash so that equal texts share one ID however they were
+// built, and spelled out only when it is printed.
+class JoinLabels {
+public:
+    // ID of a plain label
+    int intern(const std::string& text);
+
+    // ID of prefix + left + "_" + right, without spelling out either operand
+    int join(const std::string& prefix, int left, int right);
+
+    // ID of the label with this text, or -1 if none was interned
+    int find(const std::string& text) const;
+
+    size_t length(int id) const { return labels[id].print.length; }
+    bool isJoined(int id) const { return labels[id].left >= 0; }
+    bool matches(int id, const std::string& text) const;
+    std::string text(int id) const;
+
+    size_t size() const { return labels.size(); }
+    void clear();
+
+private:
+    // Hash modulo 2^61 - 1 with the power of the base it shifts a suffix by
+    struct Fingerprint {
+        uint64_t hash = 0;
+        uint64_t power = 1;
+        size_t length = 0;
+    };
+
+    struct Label {
+        std::string text;      // Plain labels only
+        std::string prefix;    // Joined labels: "" or "<join_type>_"
+        int left = -1;         // Operand IDs, -1 for plain labels
+        int right = -1;
+        Fingerprint print;
+    };
+
+    std::vector<Label> labels;
+    std::unordered_multimap<uint64_t, int> by_hash;
+
+    static Fingerprint fingerprint(const std::string& text);
+    static Fingerprint concat(const Fingerprint& a, const Fingerprint& b);
+    int add(Label label);
+};
+
+} // namespace witness
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "sat_solver.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace witness {
+
+// Weighted MaxSAT over a SatSolver holding the hard clauses.
+// Soft constraints are literals the solver should make true, each with a
+// positive weight. Uses implicit hitting sets: cores from assumption-based
+// solver calls are collected until a minimum-weight hitting set of the cores
+// can be falsified with the rest of the soft literals satisfied.
+class MaxSatSolver {
+public:
+    struct Result {
+        bool feasible = false;             // False when the hard clauses alone are unsatisfiable
+        bool optimal = false;              // False when the search was interrupted
+        long long cost = 0;                // Total weight of the falsified soft literals
+        std::vector<size_t> falsified;     // Indices of the falsified soft literals
+    };
+
+    explicit MaxSatSolver(SatSolver& solver);
+
+    // Soft literals must be distinct; returns the index used in Result::falsified
+    size_t addSoft(int literal, long long weight);
+
+    // On an optimal result the solver's model is an optimal assignment
+    Result solve();
+
+    size_t numCores() const { return cores.size(); }
+
+private:
+    SatSolver& solver;
+    std::vector<int> soft_literals;
+    std::vector<long long> weights;
+    std::vector<std::vector<size_t>> cores;
+
+    std::vector<size_t> minimumHittingSet() const;
+    void searchHittingSet(std::vector<char>& chosen, long long cost,
+                          long long& best_cost, std::vector<char>& best) const;
+    std::vector<size_t> trimCore(const std::vector<size_t>& core);
+};
+
+} // namespace witness
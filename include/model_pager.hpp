@@ -0,0 +1,50 @@
+#pragma once
+
+#include "bdd.hpp"
+#include "big_count.hpp"
+#include "clause_info.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace witness {
+
+// Random access to the models of a clause block in canonical order: the order
+// of the exhaustive truth table, where the highest asset ID is the most
+// significant bit. The block is compiled once into a decision diagram with
+// per-node model counts, and the k-th model is unranked in one root-to-leaf
+// walk, so a page never enumerates the models before it.
+class ModelPager {
+public:
+    // Models are projected onto the given asset IDs; the block's other assets
+    // are existentially quantified. asset_vars maps names to asset IDs.
+    ModelPager(ClauseView clauses, const std::unordered_map<std::string, int>& asset_vars,
+               const std::vector<int>& projection);
+
+    // False when the decision diagram exceeded its node limit
+    bool available() const { return !overflow; }
+
+    // Number of distinct projected models
+    const BigCount& size() const { return total; }
+
+    // The model of the given rank (0-based) as signed asset IDs, ascending
+    std::vector<int> model(BigCount rank) const;
+
+    // Up to count models starting at rank offset
+    std::vector<std::vector<int>> page(const BigCount& offset, size_t count) const;
+
+private:
+    std::vector<int> asset_ids;   // Projection, ascending
+    Bdd bdd;
+    Bdd::Node root;
+    bool overflow;
+    std::vector<BigCount> counts;   // Models of each node over the projected levels below it
+    BigCount total;
+
+    int depth() const { return static_cast<int>(asset_ids.size()); }
+    int levelOf(Bdd::Node node) const;
+    BigCount modelsFrom(Bdd::Node node, int from_level) const;
+};
+
+} // namespace witness
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace witness {
+
+// Objective for --optimize: a weighted sum over the assets set true.
+// Syntax: min|max[:TERM[,TERM...]] where TERM is "assets" (every asset) or
+// KIND=NAME with KIND one of asset, subject, action, object, optionally
+// followed by @WEIGHT (default 1). Without terms every asset weighs 1.
+//   --optimize=min:subject=arrendatario
+//   --optimize=max:action=pagar_renta_mensual@3,assets
+struct OptimizeQuery {
+    struct Term {
+        std::string kind;       // "assets", "asset", "subject", "action" or "object"
+        std::string name;       // Identifier matched against the asset or its component
+        long long weight = 1;
+    };
+
+    bool maximize = false;
+    std::vector<Term> terms;
+
+    // Returns false and sets error when the text is not a valid query
+    static bool parse(const std::string& text, OptimizeQuery& query, std::string& error);
+
+    // Weight of an asset given its name and (subject, action, object) components
+    long long weightOf(const std::string& asset_name, const std::vector<std::string>& components) const;
+
+    std::string describe() const;
+};
+
+} // namespace witness
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace witness {
+
+// Incremental CDCL solver used by the built-in analysis engines.
+// Literals use the DIMACS convention: variable v is the literal v, its negation is -v.
+// Asset IDs are used directly as variable numbers, auxiliary variables come from newVar().
+class SatSolver {
+public:
+    enum class Result { Satisfiable, Unsatisfiable, Unknown };
+
+    SatSolver();
+
+    // Variable management
+    int newVar();
+    void reserveVars(int count);
+    int numVars() const;
+
+    // Add a clause at decision level 0; returns false once the clause set is unsatisfiable
+    bool addClause(const std::vector<int>& literals);
+    bool okay() const;
+
+    // Solve under the given assumption literals
+    Result solve(const std::vector<int>& assumptions = {});
+
+    // Model of the last satisfiable call
+    bool modelValue(int var) const;
+    const std::vector<int8_t>& model() const;
+
+    // Subset of the assumptions responsible for the last unsatisfiable call
+    const std::vector<int>& conflictAssumptions() const;
+
+    // Cooperative cancellation: solve() returns Unknown once the flag is raised
+    void setInterruptFlag(const std::atomic<bool>* flag);
+
+    // Default phase for fresh decisions (false prefers small models)
+    void setDefaultPolarity(bool value);
+
+private:
+    struct Clause {
+        std::vector<int> lits;   // Internal literals (2 * var + sign)
+        bool learnt = false;
+        bool deleted = false;
+        double activity = 0.0;
+    };
+
+    struct Watcher {
+        int cref;
+        int blocker;
+    };
+
+    bool ok;
+    std::vector<Clause> clauses;
+    std::vector<int> learnts;
+    std::vector<std::vector<Watcher>> watches;
+
+    std::vector<int8_t> assigns;      // Per variable: 1 true, -1 false, 0 unassigned
+    std::vector<int> levels;
+    std::vector<int> reasons;
+    std::vector<int8_t> polarity;
+    std::vector<double> activity;
+    std::vector<char> seen;
+
+    std::vector<int> trail;
+    std::vector<int> trail_lim;
+    size_t qhead;
+
+    std::vector<int> heap;            // Binary max-heap of variables ordered by activity
+    std::vector<int> heap_index;
+
+    double var_inc;
+    double cla_inc;
+    double max_learnts;
+    bool default_polarity;
+
+    std::vector<int8_t> model_values;
+    std::vector<int> conflict_assumptions;
+    const std::atomic<bool>* interrupt_flag;
+
+    // Literal helpers
+    static int toInternal(int lit) { return lit > 0 ? 2 * lit : 2 * (-lit) + 1; }
+    static int toExternal(int lit) { return (lit & 1) ? -(lit >> 1) : (lit >> 1); }
+    static int var(int lit) { return lit >> 1; }
+    static int neg(int lit) { return lit ^ 1; }
+    int8_t litValue(int lit) const {
+        int8_t v = assigns[var(lit)];
+        return (lit & 1) ? static_cast<int8_t>(-v) : v;
+    }
+    int decisionLevel() const { return static_cast<int>(trail_lim.size()); }
+
+    // Core CDCL machinery
+    void enqueue(int lit, int reason);
+    int propagate();
+    void analyze(int confl, std::vector<int>& out_learnt, int& out_btlevel);
+    void analyzeFinal(int lit, const std::vector<int>& assumptions);
+    void cancelUntil(int level);
+    int pickBranchLit();
+    int attachClause(const std::vector<int>& lits, bool learnt);
+    void reduceLearnts();
+    bool locked(int cref) const;
+
+    // Activity heuristics
+    void bumpVar(int v);
+    void bumpClause(int cref);
+    void heapInsert(int v);
+    void heapUp(size_t pos);
+    void heapDown(size_t pos);
+    int heapPop();
+
+    static long long luby(long long index);
+};
+
+} // namespace witness
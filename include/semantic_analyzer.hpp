@@ -1,9 +1,15 @@
 #ifndef SEMANTIC_ANALYZER_HPP
 #define SEMANTIC_ANALYZER_HPP
 
+#include "action_dictionary.hpp"
 #include "ast.hpp"
 #include "clause_info.hpp"
+#include "concept_lattice.hpp"
 #include "conflict_analyzer.hpp"
+#include "engine_selector.hpp"
+#include "join_labels.hpp"
+#include "optimize_query.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -12,6 +18,8 @@
 #include <utility>
 #include <set>
 #include <map>
+#include <atomic>
+#include <istream>
 
 
 namespace witness {
@@ -26,6 +34,9 @@ struct TypeInfo {
     
     // For assets: store the components (subject, action, object)
     std::vector<std::string> asset_components;
+    // For join assets: the interned action label; asset_components[1] is
+    // left empty and the label is spelled out where it is printed
+    int action_label = -1;
     
     TypeInfo() : type_keyword(""), constraint("") {}
     TypeInfo(const std::string& keyword, const std::string& constraint)
@@ -55,7 +66,75 @@ public:
     // Solver mode management
     void setSolverMode(const std::string& mode);
     std::string getSolverMode() const;
+    
+    // Model reporting mode management
+    void setModelsMode(const std::string& mode);
+    std::string getModelsMode() const;
+    
+    // Report only models offset..offset+count-1 in truth table order (count 0 reports all)
+    void setModelsPage(uint64_t offset, size_t count);
+    
+    // Optimization query management (empty disables optimization)
+    void setOptimizeQuery(const std::string& query);
+    std::string getOptimizeQuery() const;
+    
+    // Wall-clock budget for MUS/MCS enumeration in conflict reports (0 disables)
+    void setConflictBudget(double seconds);
+    double getConflictBudget() const;
+    
+    // Locate the clause that first makes an unsatisfiable block inconsistent
+    void setEarliestConflict(bool enabled);
+    bool getEarliestConflict() const;
+    
+    // Report assets forced true or false in every model of each satisfiable block
+    void setBackboneMode(bool enabled);
+    bool getBackboneMode() const;
+    
+    // Report per-asset model counts of each satisfiable block, optionally
+    // weighted by asset likelihoods given as "name@p,name@p"
+    void setMarginalsMode(bool enabled);
+    bool getMarginalsMode() const;
+    void setAssetLikelihoods(const std::string& spec);
+    static bool parseLikelihoods(const std::string& spec, std::unordered_map<std::string, double>& likelihoods,
+                                 std::string& error);
+    
+    // Report redundant, tautological and contradictory clauses of each block
+    void setLintRedundant(bool enabled);
+    bool getLintRedundant() const;
+    
+    // Report how each block's model count changes without each of its clauses
+    void setClauseImpact(bool enabled);
+    bool getClauseImpact() const;
+    
+    // Report every reciprocal asset pair that satisfies a contextual join
+    void setSuggestJoins(bool enabled);
+    bool getSuggestJoins() const;
+    
+    // Report party(subject) for every subject at each global() block
+    void setPartiesMode(bool enabled);
+    bool getPartiesMode() const;
+    
+    // Extra keywords for inferring the type of inline action literals
+    void addActionDictionary(const std::vector<ActionPattern>& patterns);
+    
+    // Target sets evaluated as litis() queries against every global() block;
+    // parseQueries reads one set per line, names separated by commas or spaces
+    void setLitisQueries(const std::vector<std::vector<std::string>>& queries);
+    static bool parseQueries(std::istream& input, std::vector<std::vector<std::string>>& queries, std::string& error);
+    
+    // Component queries answered from the concept lattice once every asset is registered
+    void setAttributeQueries(const std::vector<ConceptLattice::Attributes>& queries);
 
+    // Collect-only mode: global() and litis() record their clause blocks instead
+    // of solving them, for tools such as the equivalence checker
+    void setCollectBlocksOnly(bool enabled);
+    const std::vector<ClauseBlock>& getCollectedBlocks() const;
+    const std::unordered_map<std::string, int>& getAssetIDs() const;
+    // Names of every asset declared with components, whether or not a clause uses it
+    std::vector<std::string> getDeclaredAssets() const;
+    std::vector<std::string> getAssetComponentsByName(const std::string& asset_name);
+    const std::vector<std::string>& getErrors() const;
+    
     // Verbosity control
     void setVerbose(bool verbose);
     void setQuiet(bool quiet);
@@ -89,16 +168,143 @@ public:
     // Truth table generation for satisfiability checking
     SatisfiabilityResult generateTruthTable();
     SatisfiabilityResult generateExhaustiveTruthTable();
-    SatisfiabilityResult generateSelectiveTruthTable(const std::vector<std::string>& target_assets);
-    SatisfiabilityResult generateSelectiveExternalTruthTable(const std::vector<std::string>& target_assets);
+    // Selective variants enumerate the cone litis() already collected for the targets.
+    // The exhaustive and SAT engines share one projected enumeration and differ
+    // only in the label of their progress warnings
+    SatisfiabilityResult generateSelectiveTruthTable(const std::vector<std::string>& target_assets,
+                                                     ClauseView relevant_clauses,
+                                                     const std::string& engine_label);
+    SatisfiabilityResult generateSelectiveExternalTruthTable(const std::vector<std::string>& target_assets,
+                                                             ClauseView relevant_clauses);
+    SatisfiabilityResult generateSatTruthTable();
+    
+    // Engine selection for --solver=auto
+    std::string selectEngine(ClauseView clauses);
+    std::vector<ClauseTable> buildClauseTables(ClauseView clauses);
+    
+    // SAT-based model enumeration over the given assets; returns false if cancelled
+    bool enumerateModels(ClauseView clauses, const std::vector<int>& asset_ids,
+                         std::vector<std::vector<int>>& models, const std::atomic<bool>* cancel = nullptr);
+    
+    // Exhaustive enumeration over the given assets; returns false if cancelled
+    bool enumerateExhaustive(ClauseView clauses, const std::vector<int>& asset_ids,
+                             std::vector<std::vector<int>>& models, const std::atomic<bool>* cancel = nullptr);
+    
+    // Subset-minimal models via shrink-and-block; returns false if cancelled
+    bool enumerateMinimalModels(ClauseView clauses, const std::vector<int>& asset_ids,
+                                std::vector<std::vector<int>>& models, const std::atomic<bool>* cancel = nullptr);
+    SatisfiabilityResult generateMinimalModelTruthTable(ClauseView clauses);
+    
+    // Backbone by model-based filtering plus one assumption check per surviving
+    // candidate; fills the forced literals and returns false if the clauses are unsatisfiable
+    bool computeBackbone(ClauseView clauses, const std::vector<int>& asset_ids,
+                         std::vector<int>& backbone, const std::atomic<bool>* cancel = nullptr);
+    // Prints the backbone; returns false if the clauses are unsatisfiable
+    bool reportBackbone(ClauseView clauses);
+    
+    // --backbone and --marginals answer satisfiability on their own, so the
+    // block is not enumerated unless another mode needs its models
+    bool reportsDecideSatisfiability() const;
+    
+    // Prints the requested reports and decides the block from them; returns
+    // false when neither could decide, after which the block is enumerated
+    bool decideWithoutEnumeration(ClauseView clauses, SatisfiabilityResult& result);
+    
+    // Conflict report for an unsatisfiable block, as the enumerating engines print it
+    SatisfiabilityResult unsatisfiableResult(ClauseView clauses);
+    
+    // Asset IDs of a block ordered by first mention, so related assets
+    // sit close together in a decision diagram; fills name -> variable
+    std::vector<int> diagramVariables(ClauseView clauses,
+                                      std::unordered_map<std::string, int>& var_of);
+    
+    // Per-asset model counts from one pass over the block's decision diagram;
+    // returns false when the diagram overflowed, otherwise sets whether its
+    // root is satisfiable
+    bool reportMarginals(ClauseView clauses, bool& satisfiable);
+    
+    // Model-count delta per removed clause, from prefix and suffix conjunctions
+    // on one decision diagram, counted in parallel
+    void reportClauseImpact(ClauseView clauses);
+    
+    // Models of the current block projected onto each target set, in parallel:
+    // the block is encoded once with a selector per clause and each set assumes
+    // the selectors of its cone. Fills cones, sorted target IDs in the cone and
+    // models (none when the cone is unsatisfiable); returns whether the whole
+    // block is satisfiable
+    bool projectTargetSets(const std::vector<std::vector<std::string>>& target_sets,
+                           std::vector<std::vector<size_t>>& cones, std::vector<std::vector<int>>& targets,
+                           std::vector<std::vector<std::vector<int>>>& models);
+    
+    // All --queries target sets against the current block
+    void reportLitisQueries();
+    
+    // Assets matching each --assets-with query
+    void reportAttributeQueries();
+    
+    // Assets of the current block with the subject on either side, and the
+    // distinct configurations of obligations (subject first) and claims
+    // (subject last) that the block allows for that party
+    std::vector<std::string> partyAssets(const std::string& subject);
+    std::string describePartyProjection(const std::string& subject, size_t cone_size, const std::vector<int>& targets,
+                                        std::vector<std::vector<int>>& models, bool satisfiable);
+    
+    // party(subject) for every subject of the current block, from --parties
+    void reportPartyProjections();
+    
+    // Every MUS and MCS of an unsatisfiable block within the --all-conflicts
+    // budget, printed after its conflict report unless quiet
+    void reportConflictEnumeration(const std::vector<ClauseInfo>& clauses,
+                                   const std::unordered_map<int, std::string>& asset_mapping);
+    
+    // Redundancy pass over a block before it is solved
+    void reportClauseLint(ClauseView clauses);
+    
+    // Valid contextual join candidates across all assets of the program, from
+    // one hash on (subject, object) probed with each reciprocal pair
+    void reportJoinSuggestions(Program* program);
+    
+    // One page of models unranked from the block's decision diagram, projected
+    // onto the given assets; false when the diagram is too large or has no
+    // models, leaving the engines to report the block
+    bool generatePagedTruthTable(ClauseView clauses, const std::vector<int>& projection,
+                                 SatisfiabilityResult& result);
+    
+    // Single optimal model for the --optimize objective, found with weighted MaxSAT
+    SatisfiabilityResult generateOptimalTruthTable(ClauseView clauses);
+    
+    // Race every available engine on the clauses and keep the first answer
+    SatisfiabilityResult generatePortfolioTruthTable(ClauseView clauses);
+    
+    // Cone of influence of the target assets: indices into current_clauses of
+    // the clauses connected to a target through a chain of shared assets, in
+    // source order. The walk follows the occurrence index, so its cost tracks
+    // the size of the cone, not of the block
+    std::vector<size_t> relevantClauseIndices(const std::vector<std::string>& target_assets);
+    
+    // Target asset IDs that occur in the cone, sorted; litis() models are projected onto them
+    std::vector<int> projectionAssetIDs(ClauseView relevant_clauses,
+                                        const std::vector<std::string>& target_assets);
     
     // Meet operation analysis
+    // Common legal ground of two operands: the intersection of their model
+    // sets, as the product of their decision diagrams. A clause operand stands
+    // for its own expression, an asset operand for its cone in the current block
     SatisfiabilityResult generateMeetAnalysis(const std::string& left_asset, const std::string& right_asset);
+    bool meetOperandClauses(const std::string& operand, std::vector<ClauseInfo>& clauses);
     void processDeferredMeetOperations();
     void tryProcessDeferredMeetOperations();
     void exportForCudaSolver(const std::vector<std::set<std::vector<int>>>& clause_satisfying_assignments, 
                              const std::set<int>& all_asset_ids);
     void generateExternalSolverTruthTable();
+    // A scratch export goes to the temp directory without the CudaSet dump or
+    // debug output, for callers that remove the files once the solver has run
+    bool exportExternalSolverInput(ClauseView clauses, std::string& json_filename,
+                                   std::string& result_filename, bool scratch = false);
+    bool readExternalSolverResults(const std::string& result_filename, std::vector<std::vector<int>>& assignments);
+    // Expand the solver's combinations into signed assignments over every
+    // asset ID (fewer than 64), in exhaustive enumeration order, as the other engines report them
+    static void normalizeExternalModels(const std::vector<int>& asset_ids, std::vector<std::vector<int>>& models);
     
     // Helper methods for external solver mode
     bool assignmentsCompatible(const std::vector<int>& assignment1, const std::vector<int>& assignment2);
@@ -107,6 +313,8 @@ public:
     // Clause collection for satisfiability checking
     void addClause(const std::string& clause_name, const std::vector<int>& positive_literals, 
                    const std::vector<int>& negative_literals, const std::string& expression, Expression* expr);
+    // Empty the current block together with its occurrence index
+    void clearClauses();
     
     // Validate join operation semantics
     bool validateJoinOperation(const std::string& join_type, 
@@ -119,6 +327,8 @@ public:
                                            const std::vector<std::string>& c_components);
     // Helper for per-clause truth table generation
     void collectAssetIDs(Expression* expr, std::set<int>& ids);
+    // First identifier of an expression that does not name a defined asset, or empty
+    std::string findUndefinedAsset(Expression* expr);
     bool evalExpr(Expression* expr, const std::map<int, bool>& assignment);
     
     // Error reporting
@@ -145,9 +355,57 @@ private:
     std::vector<std::string> errors;
     std::vector<std::string> warnings;
     
-    // Solver mode: "exhaustive" or "external"
+    // Solver mode: "exhaustive", "external", "sat", "auto" or "portfolio"
     std::string solverMode;
     
+    // Models mode: "all" or "minimal" (subset-minimal sets of true assets)
+    std::string modelsMode;
+    
+    // Page of models from --models-page; count 0 when disabled
+    uint64_t models_page_offset;
+    size_t models_page_count;
+    
+    // Backbone reporting from --backbone
+    bool backboneMode;
+    
+    // Clause redundancy pass from --lint-redundant
+    bool lintRedundant;
+    
+    // Per-clause model-count delta from --clause-impact
+    bool clauseImpact;
+    
+    // Contextual join discovery from --suggest-joins
+    bool suggestJoins;
+    
+    // Per-subject projections from --parties
+    bool partiesMode;
+    
+    // Keyword automaton behind inferActionType, extended by --action-dictionary
+    ActionDictionary action_dictionary;
+    
+    // Target sets from --queries
+    std::vector<std::vector<std::string>> litis_queries;
+    
+    // Component queries from --assets-with
+    std::vector<ConceptLattice::Attributes> attribute_queries;
+    
+    // Blocks recorded in collect-only mode
+    bool collectBlocksOnly;
+    std::vector<ClauseBlock> collected_blocks;
+    void collectBlock(const std::string& operation, ClauseView clauses);
+    
+    // Marginal counts from --marginals, with likelihoods by asset name (default 0.5)
+    bool marginalsMode;
+    std::unordered_map<std::string, double> asset_likelihoods;
+    
+    // Optimization query from --optimize; empty when disabled
+    std::string optimizeQuery;
+    OptimizeQuery optimize_query;
+    
+    // Engine selection state for --solver=auto and --solver=portfolio
+    EngineSelector engine_selector;
+    int block_counter;
+    
     // Verbosity flags
     bool verbose;
     bool quiet;
@@ -159,6 +417,21 @@ private:
     // Current clauses for satisfiability checking
     std::vector<ClauseInfo> current_clauses;
     
+    // Assets x (subject, action, object) concepts, extended as assets are registered
+    ConceptLattice component_lattice;
+    
+    // Join resolution state, cleared with the symbol table: components per
+    // inline expression list, the interned action labels of join assets, and
+    // the longest action name a joined label could match
+    std::unordered_map<Expression*, std::vector<std::string>> resolved_components;
+    JoinLabels join_labels;
+    size_t longest_action_name = 0;
+    
+    // Occurrence index kept in step with current_clauses by addClause:
+    // asset IDs of each clause, and clause indices per asset ID
+    std::vector<std::vector<int>> clause_asset_ids;
+    std::unordered_map<int, std::vector<size_t>> asset_clause_index;
+    
     // Deferred meet operations to process after all clauses are analyzed
     struct DeferredMeetOperation {
         std::string left_asset;
@@ -200,6 +473,8 @@ private:
     bool validateLitisOperation(FunctionCallExpression* func_call);
     bool validateMeetOperation(FunctionCallExpression* func_call, const std::string& asset_name = "");
     bool validateDomainOperation(FunctionCallExpression* func_call);
+    bool validateEntailsOperation(FunctionCallExpression* func_call);
+    bool validatePartyOperation(FunctionCallExpression* func_call);
     
     // Specific contextual join validators
     bool validateTransferJoin(Expression* left, Expression* right);
@@ -213,7 +488,16 @@ private:
     
     // Asset analysis helpers
     bool isAssetExpression(Expression* expr);
-    std::vector<std::string> getAssetComponents(Expression* asset);
+    // Components of a defined asset, or of an inline expression list resolved
+    // once per expression; empty for anything else
+    const std::vector<std::string>& getAssetComponents(Expression* asset);
+    // Interned action label of an asset with at least 3 components
+    int actionLabel(Expression* asset);
+    // Action component of an asset, spelling out a join asset's label
+    std::string actionText(const TypeInfo& asset_info) const;
+    // Components as the concept lattice keys them: a joined label by its ID,
+    // which equal texts share
+    std::vector<std::string> latticeComponents(const std::vector<std::string>& components, int action_label);
     std::string getAssetSubject(Expression* asset);
     std::string getAssetAction(Expression* asset);
     std::string getAssetObject(Expression* asset);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace witness {
+
+// Result of racing several engines on the same block
+struct PortfolioOutcome {
+    std::string winner;                          // Empty when no engine answered
+    double elapsed_ms = 0.0;                     // Time until the winning answer
+    std::vector<std::vector<int>> assignments;   // Satisfying assignments from the winner
+    std::vector<std::string> cancelled;          // Engines outrun by the winner
+    std::vector<std::string> failed;             // Engines that finished without an answer
+};
+
+// Runs engines concurrently and keeps the first definitive answer.
+// Engines poll the cancel flag and return early once another engine has won.
+class SolverPortfolio {
+public:
+    // Returns true when the assignments are a complete answer for the block
+    using Engine = std::function<bool(const std::atomic<bool>& cancel, std::vector<std::vector<int>>& assignments)>;
+
+    void addEngine(const std::string& name, Engine engine);
+    bool empty() const { return engines.empty(); }
+
+    PortfolioOutcome race();
+
+    // Run a command as a child process with its output discarded, killing it if cancel is raised.
+    // Returns the exit status, or -1 if the process could not run or was cancelled.
+    static int runCancellable(const std::vector<std::string>& argv, const std::atomic<bool>& cancel);
+
+private:
+    std::vector<std::pair<std::string, Engine>> engines;
+};
+
+} // namespace witness
@@ -0,0 +1,217 @@
+#include "action_dictionary.hpp"
+#include <algorithm>
+#include <cctype>
+#include <queue>
+
+namespace witness {
+
+namespace {
+
+// Categories in priority order; the last one is the money fallback, which
+// only applies when no other keyword matches
+const std::pair<const char*, const char*> categories[] = {
+    {"service", "positive"},
+    {"service", "negative"},
+    {"object", "movable"},
+    {"object", "non_movable"},
+    {"service", "positive"},
+};
+const int no_match = sizeof(categories) / sizeof(categories[0]);
+
+std::string lowercase(const std::string& text) {
+    std::string lower = text;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+std::string trim(const std::string& text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(start, end - start + 1);
+}
+
+} // namespace
+
+ActionDictionary::ActionDictionary() {
+    // Positive service actions (payment, provision, delivery)
+    for (const char* keyword : {
+             "pay", "charge", "bill", "invoice", "compensate", "remunerate", "salary", "wage",
+             "provide", "supply", "deliver", "give", "offer", "grant", "award", "bestow",
+             "serve", "assist", "help", "support", "maintain", "care", "tend", "feed",
+             "repair", "fix", "restore", "renovate", "improve", "enhance", "upgrade",
+             "teach", "train", "educate", "inform", "advise", "counsel", "guide", "direct"}) {
+        add(keyword, 0);
+    }
+
+    // Negative service actions (restrictions, obligations, prohibitions)
+    for (const char* keyword : {
+             "forbid", "prohibit", "ban", "restrict", "limit", "constrain", "confine",
+             "abstain", "refrain", "avoid", "prevent", "stop", "cease", "desist",
+             "obligation", "duty", "requirement", "compulsion", "mandate", "impose",
+             "burden", "encumber", "bind", "tie", "commit", "pledge", "vow",
+             "silence", "secrecy", "confidentiality", "nondisclosure", "privacy"}) {
+        add(keyword, 1);
+    }
+
+    // Movable object actions (transfer, possession, handling)
+    for (const char* keyword : {
+             "transfer", "convey", "transport", "move", "shift", "carry", "bear",
+             "sell", "buy", "purchase", "acquire", "obtain", "get", "receive",
+             "exchange", "trade", "swap", "barter", "negotiate", "deal",
+             "lend", "loan", "borrow", "rent", "lease", "hire", "charter",
+             "deliver", "ship", "send", "mail", "post", "dispatch", "forward",
+             "hand", "pass", "transmit", "relay", "convey", "communicate"}) {
+        add(keyword, 2);
+    }
+
+    // Non-movable object actions (real estate, property, location)
+    for (const char* keyword : {
+             "own", "possess", "hold", "have", "control", "command", "dominate",
+             "occupy", "inhabit", "dwell", "reside", "live", "stay", "remain",
+             "build", "construct", "erect", "establish", "found", "create",
+             "demolish", "destroy", "tear", "raze", "level", "flatten",
+             "register", "record", "inscribe", "enroll", "list", "catalog",
+             "mortgage", "lien", "encumber", "secure", "guarantee", "pledge"}) {
+        add(keyword, 3);
+    }
+
+    // Actions involving money/payment typically relate to services
+    for (const char* keyword : {"price", "cost", "fee", "tax", "interest"}) {
+        add(keyword, 4);
+    }
+}
+
+void ActionDictionary::add(const std::string& keyword, int category) {
+    if (keyword.empty()) return;
+    keywords.push_back({lowercase(keyword), category});
+    built = false;
+}
+
+void ActionDictionary::addPatterns(const std::vector<ActionPattern>& patterns) {
+    for (const auto& pattern : patterns) {
+        for (int category = 0; category < 4; category++) {
+            if (pattern.type == categories[category].first && pattern.constraint == categories[category].second) {
+                add(pattern.pattern, category);
+                break;
+            }
+        }
+    }
+    memo.clear();
+}
+
+void ActionDictionary::build() {
+    State empty;
+    empty.next.fill(-1);
+    empty.category = no_match;
+    states.assign(1, empty);
+
+    // Trie of all keywords
+    for (const auto& keyword : keywords) {
+        int state = 0;
+        for (unsigned char c : keyword.first) {
+            if (states[state].next[c] < 0) {
+                states[state].next[c] = static_cast<int>(states.size());
+                states.push_back(empty);
+            }
+            state = states[state].next[c];
+        }
+        states[state].category = std::min(states[state].category, keyword.second);
+    }
+
+    // Breadth-first: failure links complete the transition function, and each
+    // state inherits the best category of its longest proper suffix
+    std::vector<int> fail(states.size(), 0);
+    std::queue<int> pending;
+    for (int c = 0; c < 256; c++) {
+        int child = states[0].next[c];
+        if (child < 0) {
+            states[0].next[c] = 0;
+        } else {
+            pending.push(child);
+        }
+    }
+    while (!pending.empty()) {
+        int state = pending.front();
+        pending.pop();
+        states[state].category = std::min(states[state].category, states[fail[state]].category);
+        for (int c = 0; c < 256; c++) {
+            int child = states[state].next[c];
+            if (child < 0) {
+                states[state].next[c] = states[fail[state]].next[c];
+            } else {
+                fail[child] = states[fail[state]].next[c];
+                pending.push(child);
+            }
+        }
+    }
+    built = true;
+}
+
+std::pair<std::string, std::string> ActionDictionary::infer(const std::string& action) {
+    auto cached = memo.find(action);
+    int best = no_match;
+    if (cached != memo.end()) {
+        best = cached->second;
+    } else {
+        if (!built) build();
+        int state = 0;
+        for (unsigned char c : action) {
+            state = states[state].next[std::tolower(c)];
+            best = std::min(best, states[state].category);
+            if (best == 0) break;
+        }
+        memo[action] = best;
+    }
+
+    // Unknown actions default to a movable object, since most actions involve transferable items
+    if (best == no_match) return {"object", "movable"};
+    return {categories[best].first, categories[best].second};
+}
+
+bool ActionDictionary::parse(std::istream& input, std::vector<ActionPattern>& patterns, std::string& error) {
+    std::string line;
+    int line_number = 0;
+    while (std::getline(input, line)) {
+        line_number++;
+        size_t comment = std::min(line.find('#'), line.find("//"));
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        size_t colon = line.find(':');
+        std::string type;
+        std::string constraint;
+        if (colon != std::string::npos) {
+            std::string head = trim(line.substr(0, colon));
+            size_t space = head.find_first_of(" \t");
+            if (space != std::string::npos) {
+                type = head.substr(0, space);
+                constraint = trim(head.substr(space));
+            }
+        }
+        bool known = false;
+        for (int category = 0; category < 4; category++) {
+            known = known || (type == categories[category].first && constraint == categories[category].second);
+        }
+        if (!known) {
+            error = "line " + std::to_string(line_number) +
+                    ": expected 'service positive|negative' or 'object movable|non_movable' followed by ':'";
+            return false;
+        }
+
+        std::string rest = line.substr(colon + 1);
+        size_t start = 0;
+        while (start <= rest.size()) {
+            size_t end = rest.find(',', start);
+            if (end == std::string::npos) end = rest.size();
+            std::string keyword = trim(rest.substr(start, end - start));
+            if (!keyword.empty()) patterns.push_back({keyword, type, constraint});
+            start = end + 1;
+        }
+    }
+    return true;
+}
+
+} // namespace witness
@@ -0,0 +1,275 @@
+#include "bdd.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace witness {
+
+Bdd::Bdd(int num_vars, size_t max_nodes) : num_vars(num_vars), max_nodes(max_nodes), overflow(false) {
+    // Terminals sit below every variable
+    nodes.push_back({num_vars, False, False});
+    nodes.push_back({num_vars, True, True});
+}
+
+Bdd::Node Bdd::make(int var, Node low, Node high) {
+    if (low == high) return low;
+    std::pair<long long, int> key((static_cast<long long>(low) << 32) | static_cast<unsigned>(high), var);
+    auto it = unique.find(key);
+    if (it != unique.end()) return it->second;
+    if (nodes.size() >= max_nodes) {
+        overflow = true;
+        return False;
+    }
+    Node node = static_cast<Node>(nodes.size());
+    nodes.push_back({var, low, high});
+    unique[key] = node;
+    return node;
+}
+
+Bdd::Node Bdd::variable(int var) {
+    return make(var, False, True);
+}
+
+Bdd::Node Bdd::negate(Node f) {
+    return apply(Op::Xor, f, True);
+}
+
+Bdd::Node Bdd::conjoin(Node f, Node g) {
+    return apply(Op::And, f, g);
+}
+
+Bdd::Node Bdd::disjoin(Node f, Node g) {
+    return apply(Op::Or, f, g);
+}
+
+Bdd::Node Bdd::exclusiveOr(Node f, Node g) {
+    return apply(Op::Xor, f, g);
+}
+
+Bdd::Node Bdd::existsFrom(Node f, int first_level) {
+    // Every node other than False has a satisfying path, so anything rooted at
+    // a quantified level becomes True and only the levels above are rebuilt
+    std::unordered_map<Node, Node> memo;
+    std::function<Node(Node)> rebuild = [&](Node node) -> Node {
+        if (node == False) return False;
+        if (level(node) >= first_level) return True;
+        auto it = memo.find(node);
+        if (it != memo.end()) return it->second;
+        Node result = make(level(node), rebuild(low(node)), rebuild(high(node)));
+        memo[node] = result;
+        return result;
+    };
+    return rebuild(f);
+}
+
+Bdd::Node Bdd::apply(Op op, Node f, Node g) {
+    if (overflow) return False;
+
+    // Terminal cases
+    switch (op) {
+    case Op::And:
+        if (f == False || g == False) return False;
+        if (f == True) return g;
+        if (g == True || f == g) return f;
+        break;
+    case Op::Or:
+        if (f == True || g == True) return True;
+        if (f == False) return g;
+        if (g == False || f == g) return f;
+        break;
+    case Op::Xor:
+        if (f == g) return False;
+        if (f == False) return g;
+        if (g == False) return f;
+        break;
+    }
+
+    // All three operators are commutative, so normalize the cache key
+    if (f > g) std::swap(f, g);
+    std::pair<long long, int> key((static_cast<long long>(f) << 32) | static_cast<unsigned>(g), static_cast<int>(op));
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+
+    int var = std::min(level(f), level(g));
+    Node f_low = level(f) == var ? low(f) : f;
+    Node f_high = level(f) == var ? high(f) : f;
+    Node g_low = level(g) == var ? low(g) : g;
+    Node g_high = level(g) == var ? high(g) : g;
+    Node result = make(var, apply(op, f_low, g_low), apply(op, f_high, g_high));
+    cache[key] = result;
+    return result;
+}
+
+Bdd::Node Bdd::compile(Expression* expr, const std::unordered_map<std::string, int>& var_of) {
+    std::unordered_map<Expression*, Node> memo;
+    return compileExpr(expr, var_of, memo);
+}
+
+Bdd::Node Bdd::compileExpr(Expression* expr, const std::unordered_map<std::string, int>& var_of,
+                           std::unordered_map<Expression*, Node>& memo) {
+    if (!expr) return False;
+
+    auto cached = memo.find(expr);
+    if (cached != memo.end()) return cached->second;
+
+    Node node = False;
+    if (auto identifier = dynamic_cast<Identifier*>(expr)) {
+        auto it = var_of.find(identifier->name);
+        node = it != var_of.end() ? variable(it->second) : False;
+    }
+    else if (auto func_call = dynamic_cast<FunctionCallExpression*>(expr)) {
+        std::string function_name = func_call->function_name->name;
+        bool unary = func_call->arguments && func_call->arguments->expressions.size() == 1;
+        if ((function_name == "oblig" || function_name == "claim") && unary) {
+            node = compileExpr(func_call->arguments->expressions[0].get(), var_of, memo);
+        } else if (function_name == "not" && unary) {
+            node = negate(compileExpr(func_call->arguments->expressions[0].get(), var_of, memo));
+        }
+    }
+    else if (auto binary_op = dynamic_cast<BinaryOpExpression*>(expr)) {
+        Node left = compileExpr(binary_op->left.get(), var_of, memo);
+        Node right = compileExpr(binary_op->right.get(), var_of, memo);
+        if (binary_op->op == "IMPLIES") {
+            node = disjoin(negate(left), right);
+        } else if (binary_op->op == "AND") {
+            node = conjoin(left, right);
+        } else if (binary_op->op == "OR") {
+            node = disjoin(left, right);
+        } else if (binary_op->op == "XOR") {
+            node = exclusiveOr(left, right);
+        } else if (binary_op->op == "EQUIV") {
+            node = negate(exclusiveOr(left, right));
+        }
+    }
+    else if (auto unary_op = dynamic_cast<UnaryOpExpression*>(expr)) {
+        // evalExpr only negates the lowercase operator; anything else evaluates to false
+        if (unary_op->op == "not") {
+            node = negate(compileExpr(unary_op->operand.get(), var_of, memo));
+        }
+    }
+
+    memo[expr] = node;
+    return node;
+}
+
+std::vector<Bdd::Node> Bdd::topologicalOrder(Node f) const {
+    std::vector<Node> order;
+    std::vector<char> visited(nodes.size(), 0);
+    std::vector<std::pair<Node, bool>> stack = {{f, false}};
+    while (!stack.empty()) {
+        auto [node, expanded] = stack.back();
+        stack.pop_back();
+        if (expanded) {
+            order.push_back(node);
+            continue;
+        }
+        if (visited[node]) continue;
+        visited[node] = 1;
+        stack.push_back({node, true});
+        if (node > True) {
+            stack.push_back({low(node), false});
+            stack.push_back({high(node), false});
+        }
+    }
+    return order;
+}
+
+BigCount Bdd::countModels(Node f) const {
+    std::vector<BigCount> count(nodes.size());
+    count[True] = 1;
+    for (Node node : topologicalOrder(f)) {
+        if (node <= True) continue;
+        count[node] = (count[low(node)] << (level(low(node)) - level(node) - 1)) +
+                      (count[high(node)] << (level(high(node)) - level(node) - 1));
+    }
+    return count[f] << level(f);
+}
+
+std::vector<BigCount> Bdd::marginalCounts(Node f) const {
+    std::vector<Node> order = topologicalOrder(f);
+
+    // Bottom-up: models of each node over the variables from its level down
+    std::vector<BigCount> count(nodes.size());
+    count[True] = 1;
+    for (Node node : order) {
+        if (node <= True) continue;
+        count[node] = (count[low(node)] << (level(low(node)) - level(node) - 1)) +
+                      (count[high(node)] << (level(high(node)) - level(node) - 1));
+    }
+
+    // Top-down: assignments of the variables above each node that reach it.
+    // Edges skipping levels give half their models to each skipped variable,
+    // accumulated as ranges and summed in a final sweep.
+    std::vector<BigCount> paths(nodes.size());
+    std::vector<BigCount> marginals(num_vars);
+    std::vector<BigCount> range_start(num_vars + 1);
+    std::vector<BigCount> range_end(num_vars + 1);
+    auto addEdge = [&](int from_level, BigCount reach, Node child) {
+        int gap = level(child) - from_level - 1;
+        if (gap > 0 && !count[child].isZero()) {
+            BigCount half = (reach * count[child]) << (gap - 1);
+            range_start[from_level + 1] += half;
+            range_end[level(child)] += half;
+        }
+        if (child > True) paths[child] += reach << gap;
+    };
+    addEdge(-1, BigCount(1), f);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        Node node = *it;
+        if (node <= True) continue;
+        int var = level(node);
+        marginals[var] += (paths[node] * count[high(node)]) << (level(high(node)) - var - 1);
+        addEdge(var, paths[node], low(node));
+        addEdge(var, paths[node], high(node));
+    }
+
+    BigCount running;
+    for (int var = 0; var < num_vars; var++) {
+        running += range_start[var];
+        running -= range_end[var];
+        marginals[var] += running;
+    }
+    return marginals;
+}
+
+std::vector<double> Bdd::weightedMarginals(Node f, const std::vector<double>& probability, double& total) const {
+    std::vector<Node> order = topologicalOrder(f);
+
+    // Skipped variables sum out to a factor of one, so only branches carry weight
+    std::vector<double> weight(nodes.size(), 0.0);
+    weight[True] = 1.0;
+    for (Node node : order) {
+        if (node <= True) continue;
+        double p = probability[level(node)];
+        weight[node] = (1.0 - p) * weight[low(node)] + p * weight[high(node)];
+    }
+    total = weight[f];
+
+    std::vector<double> paths(nodes.size(), 0.0);
+    std::vector<double> marginals(num_vars, 0.0);
+    std::vector<double> range(num_vars + 1, 0.0);
+    auto addEdge = [&](int from_level, double reach, Node child) {
+        double mass = reach * weight[child];
+        range[from_level + 1] += mass;
+        range[level(child)] -= mass;
+        if (child > True) paths[child] += reach;
+    };
+    addEdge(-1, 1.0, f);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        Node node = *it;
+        if (node <= True) continue;
+        int var = level(node);
+        double p = probability[var];
+        marginals[var] += paths[node] * p * weight[high(node)];
+        addEdge(var, paths[node] * (1.0 - p), low(node));
+        addEdge(var, paths[node] * p, high(node));
+    }
+
+    double running = 0.0;
+    for (int var = 0; var < num_vars; var++) {
+        running += range[var];
+        marginals[var] += running * probability[var];
+    }
+    return marginals;
+}
+
+} // namespace witness
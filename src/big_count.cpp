@@ -0,0 +1,153 @@
+#include "big_count.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace witness {
+
+BigCount::BigCount(uint64_t value) {
+    while (value) {
+        limbs.push_back(static_cast<uint32_t>(value));
+        value >>= 32;
+    }
+}
+
+void BigCount::trim() {
+    while (!limbs.empty() && limbs.back() == 0) {
+        limbs.pop_back();
+    }
+}
+
+BigCount& BigCount::operator+=(const BigCount& other) {
+    if (limbs.size() < other.limbs.size()) {
+        limbs.resize(other.limbs.size(), 0);
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < limbs.size(); i++) {
+        uint64_t sum = carry + limbs[i] + (i < other.limbs.size() ? other.limbs[i] : 0);
+        limbs[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+        if (!carry && i >= other.limbs.size()) break;
+    }
+    if (carry) limbs.push_back(static_cast<uint32_t>(carry));
+    return *this;
+}
+
+BigCount& BigCount::operator-=(const BigCount& other) {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < limbs.size(); i++) {
+        int64_t diff = static_cast<int64_t>(limbs[i]) - borrow - (i < other.limbs.size() ? other.limbs[i] : 0);
+        borrow = diff < 0 ? 1 : 0;
+        limbs[i] = static_cast<uint32_t>(diff + (borrow << 32));
+        if (!borrow && i >= other.limbs.size()) break;
+    }
+    trim();
+    return *this;
+}
+
+BigCount& BigCount::operator<<=(unsigned bits) {
+    if (isZero() || bits == 0) return *this;
+    unsigned limb_shift = bits / 32;
+    unsigned bit_shift = bits % 32;
+    if (bit_shift) {
+        uint32_t carry = 0;
+        for (auto& limb : limbs) {
+            uint32_t next = limb >> (32 - bit_shift);
+            limb = (limb << bit_shift) | carry;
+            carry = next;
+        }
+        if (carry) limbs.push_back(carry);
+    }
+    limbs.insert(limbs.begin(), limb_shift, 0);
+    return *this;
+}
+
+BigCount BigCount::operator+(const BigCount& other) const {
+    BigCount result = *this;
+    result += other;
+    return result;
+}
+
+BigCount BigCount::operator-(const BigCount& other) const {
+    BigCount result = *this;
+    result -= other;
+    return result;
+}
+
+BigCount BigCount::operator*(const BigCount& other) const {
+    BigCount result;
+    if (isZero() || other.isZero()) return result;
+    result.limbs.assign(limbs.size() + other.limbs.size(), 0);
+    for (size_t i = 0; i < limbs.size(); i++) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < other.limbs.size(); j++) {
+            uint64_t cur = result.limbs[i + j] + static_cast<uint64_t>(limbs[i]) * other.limbs[j] + carry;
+            result.limbs[i + j] = static_cast<uint32_t>(cur);
+            carry = cur >> 32;
+        }
+        for (size_t k = i + other.limbs.size(); carry; k++) {
+            uint64_t cur = result.limbs[k] + carry;
+            result.limbs[k] = static_cast<uint32_t>(cur);
+            carry = cur >> 32;
+        }
+    }
+    result.trim();
+    return result;
+}
+
+BigCount BigCount::operator<<(unsigned bits) const {
+    BigCount result = *this;
+    result <<= bits;
+    return result;
+}
+
+bool BigCount::operator<(const BigCount& other) const {
+    if (limbs.size() != other.limbs.size()) return limbs.size() < other.limbs.size();
+    for (size_t i = limbs.size(); i-- > 0;) {
+        if (limbs[i] != other.limbs[i]) return limbs[i] < other.limbs[i];
+    }
+    return false;
+}
+
+BigCount BigCount::power2(unsigned bits) {
+    return BigCount(1) << bits;
+}
+
+BigCount BigCount::divide(uint32_t divisor, uint32_t& remainder) const {
+    BigCount quotient;
+    quotient.limbs.assign(limbs.size(), 0);
+    uint64_t rest = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        uint64_t cur = (rest << 32) | limbs[i];
+        quotient.limbs[i] = static_cast<uint32_t>(cur / divisor);
+        rest = cur % divisor;
+    }
+    quotient.trim();
+    remainder = static_cast<uint32_t>(rest);
+    return quotient;
+}
+
+double BigCount::toDouble() const {
+    double value = 0.0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        value = value * 4294967296.0 + limbs[i];
+    }
+    return value;
+}
+
+std::string BigCount::toString() const {
+    if (isZero()) return "0";
+    std::string digits;
+    BigCount rest = *this;
+    while (!rest.isZero()) {
+        uint32_t chunk = 0;
+        rest = rest.divide(1000000000u, chunk);
+        for (int i = 0; i < 9 && (chunk || !rest.isZero()); i++) {
+            digits.push_back(static_cast<char>('0' + chunk % 10));
+            chunk /= 10;
+        }
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+} // namespace witness
@@ -0,0 +1,120 @@
+#include "clause_linter.hpp"
+#include "cnf_encoder.hpp"
+#include "sat_solver.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace witness {
+
+ClauseLinter::ClauseLinter(const std::unordered_map<std::string, int>& asset_vars) : asset_vars(asset_vars) {}
+
+LintReport ClauseLinter::lint(ClauseView clauses) const {
+    LintReport report;
+
+    // Clause i is lits[i]; selectors[i] switches its constraint on
+    SatSolver solver;
+    CnfEncoder encoder(solver, asset_vars);
+    std::vector<int> lits;
+    std::vector<int> selectors;
+    for (const auto& clause : clauses) {
+        int lit = encoder.encode(clause.expr);
+        int selector = solver.newVar();
+        solver.addClause({-selector, lit});
+        lits.push_back(lit);
+        selectors.push_back(selector);
+    }
+
+    auto othersAnd = [&](const std::vector<char>& active, size_t clause, int extra) {
+        std::vector<int> assumptions;
+        for (size_t j = 0; j < selectors.size(); j++) {
+            if (j != clause && active[j]) assumptions.push_back(selectors[j]);
+        }
+        assumptions.push_back(extra);
+        return assumptions;
+    };
+
+    report.satisfiable = solver.solve(selectors) == SatSolver::Result::Satisfiable;
+
+    // Three independent checks per clause, each worker on its own solver copy
+    std::vector<char> tautology(clauses.size(), 0);
+    std::vector<char> contradiction(clauses.size(), 0);
+    std::vector<char> redundant(clauses.size(), 0);
+    std::vector<char> all_active(clauses.size(), 1);
+    unsigned num_workers = std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<unsigned>(clauses.size())));
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < num_workers; w++) {
+        workers.emplace_back([&]() {
+            SatSolver local = solver;
+            for (size_t i = next++; i < clauses.size(); i = next++) {
+                if (local.solve({-lits[i]}) == SatSolver::Result::Unsatisfiable) {
+                    tautology[i] = 1;
+                    continue;
+                }
+                if (local.solve({lits[i]}) == SatSolver::Result::Unsatisfiable) {
+                    contradiction[i] = 1;
+                    continue;
+                }
+                if (report.satisfiable &&
+                    local.solve(othersAnd(all_active, i, -lits[i])) == SatSolver::Result::Unsatisfiable) {
+                    redundant[i] = 1;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Clauses implying each other are each redundant alone but not together,
+    // so confirm a removable set one clause at a time against what remains
+    std::vector<char> active(clauses.size(), 1);
+    for (size_t i = 0; i < clauses.size(); i++) {
+        if (tautology[i]) {
+            report.tautologies.push_back(i);
+            report.removable.push_back(i);
+            active[i] = 0;
+        }
+    }
+    for (size_t i = 0; i < clauses.size(); i++) {
+        if (contradiction[i]) report.contradictions.push_back(i);
+        if (!redundant[i]) continue;
+        report.redundant.push_back(i);
+        if (solver.solve(othersAnd(active, i, -lits[i])) == SatSolver::Result::Unsatisfiable) {
+            report.removable.push_back(i);
+            active[i] = 0;
+        }
+    }
+    std::sort(report.removable.begin(), report.removable.end());
+    return report;
+}
+
+std::string ClauseLinter::format(const LintReport& report, ClauseView clauses) {
+    std::string text = "Clause lint (" + std::to_string(clauses.size()) + " clauses):\n";
+    if (report.tautologies.empty() && report.contradictions.empty() && report.redundant.empty()) {
+        return text + "  No redundant, tautological or contradictory clauses\n";
+    }
+    for (size_t i : report.tautologies) {
+        text += "  Tautology: clause '" + clauses[i].name + "' holds in every assignment\n";
+    }
+    for (size_t i : report.contradictions) {
+        text += "  Contradiction: clause '" + clauses[i].name + "' holds in no assignment\n";
+    }
+    for (size_t i : report.redundant) {
+        text += "  Redundant: clause '" + clauses[i].name + "' is implied by the rest of the block\n";
+    }
+    if (!report.satisfiable) {
+        text += "  The block is unsatisfiable, so redundancy was not checked\n";
+    }
+    if (!report.removable.empty()) {
+        text += "  Removable together:";
+        for (size_t k = 0; k < report.removable.size(); k++) {
+            text += (k > 0 ? ", " : " ") + clauses[report.removable[k]].name;
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+} // namespace witness
@@ -0,0 +1,113 @@
+#include "cnf_encoder.hpp"
+
+namespace witness {
+
+CnfEncoder::CnfEncoder(SatSolver& solver, const std::unordered_map<std::string, int>& asset_vars)
+    : solver(solver), asset_vars(asset_vars), false_lit(0) {
+    int max_var = 0;
+    for (const auto& pair : asset_vars) {
+        if (pair.second > max_var) max_var = pair.second;
+    }
+    solver.reserveVars(max_var);
+}
+
+int CnfEncoder::falseLiteral() {
+    if (false_lit == 0) {
+        false_lit = solver.newVar();
+        solver.addClause({-false_lit});
+    }
+    return false_lit;
+}
+
+void CnfEncoder::addConstraint(Expression* expr, int selector) {
+    int lit = encode(expr);
+    if (selector != 0) {
+        solver.addClause({-selector, lit});
+    } else {
+        solver.addClause({lit});
+    }
+}
+
+int CnfEncoder::encode(Expression* expr) {
+    if (!expr) return falseLiteral();
+
+    auto cached = cache.find(expr);
+    if (cached != cache.end()) {
+        return cached->second;
+    }
+
+    int lit = 0;
+    if (auto identifier = dynamic_cast<Identifier*>(expr)) {
+        auto it = asset_vars.find(identifier->name);
+        lit = it != asset_vars.end() ? it->second : falseLiteral();
+    }
+    else if (auto func_call = dynamic_cast<FunctionCallExpression*>(expr)) {
+        std::string function_name = func_call->function_name->name;
+        bool unary = func_call->arguments && func_call->arguments->expressions.size() == 1;
+        if ((function_name == "oblig" || function_name == "claim") && unary) {
+            lit = encode(func_call->arguments->expressions[0].get());
+        } else if (function_name == "not" && unary) {
+            lit = -encode(func_call->arguments->expressions[0].get());
+        } else {
+            lit = falseLiteral();
+        }
+    }
+    else if (auto binary_op = dynamic_cast<BinaryOpExpression*>(expr)) {
+        int left = encode(binary_op->left.get());
+        int right = encode(binary_op->right.get());
+        if (binary_op->op == "IMPLIES") {
+            lit = encodeOr(-left, right);
+        } else if (binary_op->op == "AND") {
+            lit = encodeAnd(left, right);
+        } else if (binary_op->op == "OR") {
+            lit = encodeOr(left, right);
+        } else if (binary_op->op == "XOR") {
+            lit = encodeXor(left, right);
+        } else if (binary_op->op == "EQUIV") {
+            lit = -encodeXor(left, right);
+        } else {
+            lit = falseLiteral();
+        }
+    }
+    else if (auto unary_op = dynamic_cast<UnaryOpExpression*>(expr)) {
+        // evalExpr only negates the lowercase operator; anything else evaluates to false
+        if (unary_op->op == "not") {
+            lit = -encode(unary_op->operand.get());
+        } else {
+            lit = falseLiteral();
+        }
+    }
+    else {
+        lit = falseLiteral();
+    }
+
+    cache[expr] = lit;
+    return lit;
+}
+
+int CnfEncoder::encodeAnd(int a, int b) {
+    int t = solver.newVar();
+    solver.addClause({-t, a});
+    solver.addClause({-t, b});
+    solver.addClause({t, -a, -b});
+    return t;
+}
+
+int CnfEncoder::encodeOr(int a, int b) {
+    int t = solver.newVar();
+    solver.addClause({t, -a});
+    solver.addClause({t, -b});
+    solver.addClause({-t, a, b});
+    return t;
+}
+
+int CnfEncoder::encodeXor(int a, int b) {
+    int t = solver.newVar();
+    solver.addClause({-t, a, b});
+    solver.addClause({-t, -a, -b});
+    solver.addClause({t, -a, b});
+    solver.addClause({t, a, -b});
+    return t;
+}
+
+} // namespace witness
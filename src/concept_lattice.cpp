@@ -0,0 +1,177 @@
+#include "concept_lattice.hpp"
+#include <algorithm>
+
+namespace witness {
+
+void ConceptLattice::addAsset(const std::string& name, const std::vector<std::string>& components) {
+    if (components.size() < 3 || asset_index.count(name)) return;
+
+    size_t index = asset_names.size();
+    asset_names.push_back(name);
+    asset_index[name] = index;
+
+    std::vector<int> intent;
+    for (int role = Subject; role <= Object; role++) {
+        auto key = std::make_pair(role, components[role]);
+        auto it = attribute_ids.find(key);
+        if (it == attribute_ids.end()) {
+            it = attribute_ids.emplace(key, static_cast<int>(attributes.size())).first;
+            attributes.push_back(key);
+            attribute_extents.push_back(Bits());
+        }
+        setBit(attribute_extents[it->second], index);
+        intent.push_back(it->second);
+    }
+    std::sort(intent.begin(), intent.end());
+    asset_intents.push_back(intent);
+
+    // Only intents below the new asset's change: existing ones gain it, and
+    // subsets that just became closed are new concepts
+    for (unsigned mask = 0; mask < 8; mask++) {
+        std::vector<int> subset;
+        for (int k = 0; k < 3; k++) {
+            if (mask & (1u << k)) subset.push_back(intent[k]);
+        }
+        auto existing = concepts.find(subset);
+        if (existing != concepts.end()) {
+            setBit(existing->second.extent, index);
+            continue;
+        }
+        Bits extent = extentOf(subset);
+        bool closed = true;
+        for (int attribute : intent) {
+            if (!std::binary_search(subset.begin(), subset.end(), attribute) &&
+                subsetOf(extent, attribute_extents[attribute])) {
+                closed = false;
+                break;
+            }
+        }
+        if (closed) concepts[subset] = {extent, subset};
+    }
+}
+
+const ConceptLattice::Concept* ConceptLattice::meet(const std::string& left, const std::string& right) const {
+    auto left_it = asset_index.find(left);
+    auto right_it = asset_index.find(right);
+    if (left_it == asset_index.end() || right_it == asset_index.end()) return nullptr;
+
+    // Intersections of closed intents are closed, so the shared attributes name a concept
+    const auto& a = asset_intents[left_it->second];
+    const auto& b = asset_intents[right_it->second];
+    std::vector<int> shared;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(shared));
+    auto it = concepts.find(shared);
+    return it != concepts.end() ? &it->second : nullptr;
+}
+
+std::string ConceptLattice::roleValue(const Concept& concept, Role role) const {
+    for (int attribute : concept.intent) {
+        if (attributes[attribute].first == role) return attributes[attribute].second;
+    }
+    return "";
+}
+
+std::vector<std::string> ConceptLattice::assetsWith(const Attributes& query) const {
+    std::vector<int> intent;
+    for (const auto& attribute : query) {
+        auto it = attribute_ids.find(std::make_pair(static_cast<int>(attribute.first), attribute.second));
+        if (it == attribute_ids.end()) return {};
+        intent.push_back(it->second);
+    }
+    return extentNames(extentOf(intent));
+}
+
+bool ConceptLattice::parseAttributes(const std::string& spec, Attributes& attributes, std::string& error) {
+    static const char* role_names[] = {"subject", "action", "object"};
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string term = spec.substr(start, end - start);
+        size_t equals = term.find('=');
+        if (equals == std::string::npos || equals + 1 == term.size()) {
+            error = "expected ROLE=VALUE, got '" + term + "'";
+            return false;
+        }
+        std::string role = term.substr(0, equals);
+        int found = -1;
+        for (int r = Subject; r <= Object; r++) {
+            if (role == role_names[r]) found = r;
+        }
+        if (found < 0) {
+            error = "unknown role '" + role + "', expected subject, action or object";
+            return false;
+        }
+        attributes.push_back({static_cast<Role>(found), term.substr(equals + 1)});
+        start = end + 1;
+    }
+    return true;
+}
+
+std::vector<std::string> ConceptLattice::extentNames(const Bits& extent) const {
+    std::vector<std::string> names;
+    for (size_t w = 0; w < extent.words.size(); w++) {
+        for (size_t bit = 0; bit < 64; bit++) {
+            size_t i = (extent.first + w) * 64 + bit;
+            if (i < asset_names.size() && extent.words[w] >> bit & 1) names.push_back(asset_names[i]);
+        }
+    }
+    return names;
+}
+
+ConceptLattice::Bits ConceptLattice::allAssets() const {
+    Bits all;
+    all.words.assign((asset_names.size() + 63) / 64, ~uint64_t(0));
+    if (asset_names.size() % 64) {
+        all.words.back() = (uint64_t(1) << (asset_names.size() % 64)) - 1;
+    }
+    return all;
+}
+
+ConceptLattice::Bits ConceptLattice::extentOf(const std::vector<int>& intent) const {
+    if (intent.empty()) return allAssets();
+
+    // Start from the shortest extent and intersect over the words all of
+    // them cover, so the cost is bounded by it rather than by the asset count
+    int shortest = intent[0];
+    for (int attribute : intent) {
+        if (attribute_extents[attribute].words.size() < attribute_extents[shortest].words.size()) shortest = attribute;
+    }
+    Bits extent = attribute_extents[shortest];
+    for (int attribute : intent) {
+        if (attribute == shortest) continue;
+        const Bits& attribute_extent = attribute_extents[attribute];
+        size_t first = std::max(extent.first, attribute_extent.first);
+        size_t end = std::min(extent.first + extent.words.size(), attribute_extent.first + attribute_extent.words.size());
+        Bits overlap;
+        overlap.first = first;
+        for (size_t w = first; w < end; w++) {
+            overlap.words.push_back(extent.words[w - extent.first] & attribute_extent.words[w - attribute_extent.first]);
+        }
+        extent = std::move(overlap);
+    }
+    return extent;
+}
+
+bool ConceptLattice::subsetOf(const Bits& a, const Bits& b) {
+    for (size_t w = 0; w < a.words.size(); w++) {
+        size_t word = a.first + w;
+        bool covered = word >= b.first && word - b.first < b.words.size();
+        if (a.words[w] & ~(covered ? b.words[word - b.first] : 0)) return false;
+    }
+    return true;
+}
+
+void ConceptLattice::setBit(Bits& bits, size_t index) {
+    size_t word = index / 64;
+    if (bits.words.empty()) {
+        bits.first = word;
+    } else if (word < bits.first) {
+        bits.words.insert(bits.words.begin(), bits.first - word, 0);
+        bits.first = word;
+    }
+    if (bits.words.size() <= word - bits.first) bits.words.resize(word - bits.first + 1, 0);
+    bits.words[word - bits.first] |= uint64_t(1) << (index % 64);
+}
+
+} // namespace witness
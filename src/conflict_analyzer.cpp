@@ -1,119 +1,374 @@
 #include "conflict_analyzer.hpp"
+#include "cnf_encoder.hpp"
+#include "maxsat_solver.hpp"
+#include "sat_solver.hpp"
 #include <iostream>
 #include <vector>
 #include <set>
 #include <unordered_map>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
 
 namespace witness {
 
-ConflictAnalyzer::ConflictAnalyzer() {
+ConflictAnalyzer::ConflictAnalyzer() : enumeration_budget(0.0), localize_earliest(false) {
     // Initialize the conflict analyzer
 }
 
+void ConflictAnalyzer::setEnumerationBudget(double seconds) {
+    enumeration_budget = seconds;
+}
+
+double ConflictAnalyzer::getEnumerationBudget() const {
+    return enumeration_budget;
+}
+
+void ConflictAnalyzer::setLocalizeEarliest(bool enabled) {
+    localize_earliest = enabled;
+}
+
+bool ConflictAnalyzer::getLocalizeEarliest() const {
+    return localize_earliest;
+}
+
 std::vector<std::string> ConflictAnalyzer::findMinimalConflictingSet(
     const std::vector<ClauseInfo>& clauses,
     const std::unordered_map<int, std::string>& asset_mapping) {
     
     std::vector<std::string> conflicting_clauses;
+    for (size_t index : findMinimalUnsatisfiableSubset(clauses, asset_mapping)) {
+        conflicting_clauses.push_back(formatClauseDescription(clauses[index], asset_mapping));
+    }
+    return conflicting_clauses;
+}
+
+std::vector<size_t> ConflictAnalyzer::findMinimalUnsatisfiableSubset(
+    const std::vector<ClauseInfo>& clauses,
+    const std::unordered_map<int, std::string>& asset_mapping) {
     
-    if (clauses.empty()) {
-        return conflicting_clauses;
+    std::unordered_map<std::string, int> asset_vars = invertAssetMapping(asset_mapping);
+    SatSolver solver;
+    std::vector<int> selectors = encodeWithSelectors(solver, clauses, asset_vars);
+    
+    if (solver.solve(selectors) != SatSolver::Result::Unsatisfiable) {
+        return {};
     }
     
-    // Strategy 1: Check for direct contradictions (same asset with opposite literals)
-    std::unordered_map<int, std::set<std::string>> asset_to_clauses;
-    std::unordered_map<int, bool> asset_positive_literal;
-    std::unordered_map<int, bool> asset_negative_literal;
+    // Start from the core of the full set rather than from every clause
+    std::unordered_map<int, size_t> index_of;
+    for (size_t i = 0; i < selectors.size(); i++) {
+        index_of[selectors[i]] = i;
+    }
+    std::vector<size_t> candidate;
+    for (int lit : solver.conflictAssumptions()) {
+        candidate.push_back(index_of[lit]);
+    }
+    std::sort(candidate.begin(), candidate.end());
     
-    // Build asset-to-clauses mapping and check for direct contradictions
-    for (const auto& clause : clauses) {
-        std::string clause_desc = formatClauseDescription(clause, asset_mapping);
-        
-        // Check positive literals
-        for (int asset_id : clause.positive_literals) {
-            asset_to_clauses[asset_id].insert(clause_desc);
-            if (asset_negative_literal.find(asset_id) != asset_negative_literal.end()) {
-                // Found contradiction: asset is both positive and negative
-                conflicting_clauses.push_back(clause_desc);
-                // Add the clause that has the negative literal
-                for (const auto& other_clause : clauses) {
-                    for (int neg_asset : other_clause.negative_literals) {
-                        if (neg_asset == asset_id) {
-                            std::string other_desc = formatClauseDescription(other_clause, asset_mapping);
-                            if (std::find(conflicting_clauses.begin(), conflicting_clauses.end(), other_desc) == conflicting_clauses.end()) {
-                                conflicting_clauses.push_back(other_desc);
-                            }
-                            break;
-                        }
-                    }
+    std::vector<size_t> mus;
+    shrinkToMus(solver, selectors, candidate, mus, true);
+    return mus;
+}
+
+bool ConflictAnalyzer::shrinkToMus(
+    SatSolver& solver,
+    const std::vector<int>& selectors,
+    std::vector<size_t> candidate,
+    std::vector<size_t>& mus,
+    bool parallel) {
+    
+    std::unordered_map<int, size_t> index_of;
+    for (size_t i = 0; i < selectors.size(); i++) {
+        index_of[selectors[i]] = i;
+    }
+    auto assumptionsWithout = [&](const std::vector<size_t>& subset, size_t skipped) {
+        std::vector<int> assumptions;
+        for (size_t i : subset) {
+            if (i != skipped) assumptions.push_back(selectors[i]);
+        }
+        return assumptions;
+    };
+    
+    // A clause whose removal makes the candidate satisfiable is in every MUS of it.
+    // These checks are independent, so each worker runs them on its own solver copy;
+    // callers shrinking many seeds leave them to the serial deletion pass instead.
+    std::vector<char> necessary(selectors.size(), 0);
+    std::atomic<bool> interrupted(false);
+    unsigned num_workers = parallel ? std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<unsigned>(candidate.size()))) : 0;
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < num_workers; w++) {
+        workers.emplace_back([&]() {
+            SatSolver local = solver;
+            for (size_t k = next++; k < candidate.size(); k = next++) {
+                SatSolver::Result result = local.solve(assumptionsWithout(candidate, candidate[k]));
+                if (result == SatSolver::Result::Satisfiable) {
+                    necessary[candidate[k]] = 1;
+                } else if (result == SatSolver::Result::Unknown) {
+                    interrupted = true;
                 }
             }
-            asset_positive_literal[asset_id] = true;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (interrupted) return false;
+    
+    // Deletion pass over the remaining clauses, shrinking to each returned core
+    mus = candidate;
+    for (size_t pos = 0; pos < mus.size();) {
+        size_t clause = mus[pos];
+        if (necessary[clause]) {
+            pos++;
+            continue;
         }
-        
-        // Check negative literals
-        for (int asset_id : clause.negative_literals) {
-            asset_to_clauses[asset_id].insert(clause_desc);
-            if (asset_positive_literal.find(asset_id) != asset_positive_literal.end()) {
-                // Found contradiction: asset is both positive and negative
-                conflicting_clauses.push_back(clause_desc);
-                // Add the clause that has the positive literal
-                for (const auto& other_clause : clauses) {
-                    for (int pos_asset : other_clause.positive_literals) {
-                        if (pos_asset == asset_id) {
-                            std::string other_desc = formatClauseDescription(other_clause, asset_mapping);
-                            if (std::find(conflicting_clauses.begin(), conflicting_clauses.end(), other_desc) == conflicting_clauses.end()) {
-                                conflicting_clauses.push_back(other_desc);
-                            }
-                            break;
-                        }
-                    }
-                }
+        SatSolver::Result result = solver.solve(assumptionsWithout(mus, clause));
+        if (result == SatSolver::Result::Unknown) {
+            return false;
+        }
+        if (result == SatSolver::Result::Unsatisfiable) {
+            std::set<size_t> core;
+            for (int lit : solver.conflictAssumptions()) {
+                core.insert(index_of[lit]);
+            }
+            std::vector<size_t> refined;
+            for (size_t i : mus) {
+                if (core.count(i)) refined.push_back(i);
             }
-            asset_negative_literal[asset_id] = true;
+            mus = refined;
+            pos = 0; // Necessary clauses stay in every core, so rescanning only skips them
+        } else {
+            necessary[clause] = 1;
+            pos++;
         }
     }
+    return true;
+}
+
+size_t ConflictAnalyzer::findEarliestConflict(
+    const std::vector<ClauseInfo>& clauses,
+    const std::unordered_map<int, std::string>& asset_mapping) {
     
-    // Strategy 2: Check for logical contradictions in binary operations
-    for (const auto& clause : clauses) {
-        if (clause.expression == "binary_op" && clause.expr) {
-            std::vector<std::string> binary_conflicts = analyzeBinaryOperationConflicts(clause, clauses, asset_mapping);
-            conflicting_clauses.insert(conflicting_clauses.end(), binary_conflicts.begin(), binary_conflicts.end());
+    std::unordered_map<std::string, int> asset_vars = invertAssetMapping(asset_mapping);
+    SatSolver solver;
+    CnfEncoder encoder(solver, asset_vars);
+    
+    // Learnt clauses carry over, so each call only has to account for the new clause
+    for (size_t i = 0; i < clauses.size(); i++) {
+        encoder.addConstraint(clauses[i].expr);
+        if (!solver.okay() || solver.solve() == SatSolver::Result::Unsatisfiable) {
+            return i;
         }
     }
+    return clauses.size();
+}
+
+ConflictEnumeration ConflictAnalyzer::enumerateConflicts(
+    const std::vector<ClauseInfo>& clauses,
+    const std::unordered_map<int, std::string>& asset_mapping,
+    double budget_seconds) {
     
-    // Remove duplicates
-    std::sort(conflicting_clauses.begin(), conflicting_clauses.end());
-    conflicting_clauses.erase(std::unique(conflicting_clauses.begin(), conflicting_clauses.end()), conflicting_clauses.end());
+    ConflictEnumeration enumeration;
+    auto start = std::chrono::steady_clock::now();
     
-    // If no direct contradictions found, add a note about complex interactions
-    if (conflicting_clauses.empty()) {
-        conflicting_clauses.push_back("No direct explicit contradictions detected");
-        conflicting_clauses.push_back("Unsatisfiability may be due to complex logical interactions between clauses");
-        conflicting_clauses.push_back("Consider reviewing clause dependencies and logical constraints");
+    std::unordered_map<std::string, int> asset_vars = invertAssetMapping(asset_mapping);
+    SatSolver solver;
+    std::vector<int> selectors = encodeWithSelectors(solver, clauses, asset_vars);
+    std::unordered_map<int, size_t> index_of;
+    for (size_t i = 0; i < selectors.size(); i++) {
+        index_of[selectors[i]] = i;
     }
     
-    return conflicting_clauses;
+    // Map solver: variable i + 1 is true when clause i is in the seed.
+    // Preferring true yields large seeds, which are cheap to shrink or grow.
+    SatSolver map;
+    map.reserveVars(static_cast<int>(clauses.size()));
+    map.setDefaultPolarity(true);
+    
+    // A watchdog raises the interrupt flag at the deadline so long solver calls stop too
+    std::atomic<bool> interrupt(false);
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    std::thread watchdog([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!finished.wait_for(lock, std::chrono::duration<double>(budget_seconds), [&]() { return done; })) {
+            interrupt = true;
+        }
+    });
+    solver.setInterruptFlag(&interrupt);
+    map.setInterruptFlag(&interrupt);
+    
+    auto assumptionsFor = [&](const std::vector<char>& in_set) {
+        std::vector<int> assumptions;
+        for (size_t i = 0; i < in_set.size(); i++) {
+            if (in_set[i]) assumptions.push_back(selectors[i]);
+        }
+        return assumptions;
+    };
+    
+    for (;;) {
+        SatSolver::Result map_result = map.solve();
+        if (map_result == SatSolver::Result::Unsatisfiable) {
+            enumeration.complete = true;
+            break;
+        }
+        if (map_result == SatSolver::Result::Unknown) break;
+        
+        std::vector<char> seed(clauses.size(), 0);
+        for (size_t i = 0; i < clauses.size(); i++) {
+            seed[i] = map.modelValue(static_cast<int>(i) + 1);
+        }
+        
+        SatSolver::Result seed_result = solver.solve(assumptionsFor(seed));
+        if (seed_result == SatSolver::Result::Unknown) break;
+        
+        if (seed_result == SatSolver::Result::Satisfiable) {
+            // Grow to a maximal satisfiable subset; the clauses left out form an MCS
+            bool interrupted = false;
+            for (size_t i = 0; i < clauses.size() && !interrupted; i++) {
+                if (seed[i]) continue;
+                seed[i] = 1;
+                SatSolver::Result result = solver.solve(assumptionsFor(seed));
+                if (result == SatSolver::Result::Unknown) interrupted = true;
+                if (result != SatSolver::Result::Satisfiable) seed[i] = 0;
+            }
+            if (interrupted) break;
+            
+            std::vector<size_t> mcs;
+            std::vector<int> block;
+            for (size_t i = 0; i < clauses.size(); i++) {
+                if (!seed[i]) {
+                    mcs.push_back(i);
+                    block.push_back(static_cast<int>(i) + 1);
+                }
+            }
+            // Every later seed must include at least one clause of the MCS
+            map.addClause(block);
+            if (mcs.empty()) continue; // All clauses are satisfiable together
+            enumeration.mcses.push_back(mcs);
+        } else {
+            std::vector<size_t> candidate;
+            for (int lit : solver.conflictAssumptions()) {
+                candidate.push_back(index_of[lit]);
+            }
+            std::sort(candidate.begin(), candidate.end());
+            
+            // Seeds are shrunk one after another, so shrink serially on the enumeration solver
+            std::vector<size_t> mus;
+            if (!shrinkToMus(solver, selectors, candidate, mus, false)) break;
+            
+            // Every later seed must leave out at least one clause of the MUS
+            std::vector<int> block;
+            for (size_t i : mus) {
+                block.push_back(-(static_cast<int>(i) + 1));
+            }
+            map.addClause(block);
+            enumeration.muses.push_back(mus);
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    finished.notify_one();
+    watchdog.join();
+    
+    enumeration.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return enumeration;
 }
 
-std::vector<std::string> ConflictAnalyzer::analyzeBinaryOperationConflicts(
-    const ClauseInfo& clause,
-    const std::vector<ClauseInfo>& all_clauses,
+Relaxation ConflictAnalyzer::findCheapestRelaxation(
+    const std::vector<ClauseInfo>& clauses,
     const std::unordered_map<int, std::string>& asset_mapping) {
     
-    std::vector<std::string> conflicts;
+    Relaxation relaxation;
+    
+    std::unordered_map<std::string, int> asset_vars = invertAssetMapping(asset_mapping);
+    
+    // Each clause is guarded by a selector; the selectors are the soft constraints
+    SatSolver solver;
+    std::vector<int> selectors = encodeWithSelectors(solver, clauses, asset_vars);
+    MaxSatSolver maxsat(solver);
+    for (size_t i = 0; i < clauses.size(); i++) {
+        maxsat.addSoft(selectors[i], clauses[i].weight);
+        relaxation.total_weight += clauses[i].weight;
+    }
     
-    // For now, we'll implement a simple heuristic for binary operations
-    // This can be expanded to handle more complex logical contradictions
+    MaxSatSolver::Result result = maxsat.solve();
+    relaxation.optimal = result.optimal;
+    if (!result.optimal) {
+        return relaxation;
+    }
+    relaxation.relaxed = result.falsified;
+    relaxation.relaxed_weight = result.cost;
     
-    // Check if this binary operation clause conflicts with other clauses
-    // by analyzing the logical implications
+    std::set<int> asset_ids;
+    for (const auto& clause : clauses) {
+        collectAssets(clause.expr, asset_vars, asset_ids);
+    }
+    for (int asset_id : asset_ids) {
+        relaxation.assignment.push_back(solver.modelValue(asset_id) ? asset_id : -asset_id);
+    }
+    return relaxation;
+}
+
+void ConflictAnalyzer::collectAssets(
+    Expression* expr,
+    const std::unordered_map<std::string, int>& asset_vars,
+    std::set<int>& ids) {
     
-    // Example: If we have clause1 = oblig(A) AND clause2 = not(A)
-    // and this binary operation combines them, it creates a contradiction
+    if (!expr) return;
     
-    return conflicts;
+    if (auto identifier = dynamic_cast<Identifier*>(expr)) {
+        auto it = asset_vars.find(identifier->name);
+        if (it != asset_vars.end()) {
+            ids.insert(it->second);
+        }
+    } else if (auto func_call = dynamic_cast<FunctionCallExpression*>(expr)) {
+        if (func_call->arguments) {
+            for (const auto& arg : func_call->arguments->expressions) {
+                collectAssets(arg.get(), asset_vars, ids);
+            }
+        }
+    } else if (auto binary_op = dynamic_cast<BinaryOpExpression*>(expr)) {
+        collectAssets(binary_op->left.get(), asset_vars, ids);
+        collectAssets(binary_op->right.get(), asset_vars, ids);
+    } else if (auto unary_op = dynamic_cast<UnaryOpExpression*>(expr)) {
+        collectAssets(unary_op->operand.get(), asset_vars, ids);
+    }
+}
+
+std::unordered_map<std::string, int> ConflictAnalyzer::invertAssetMapping(
+    const std::unordered_map<int, std::string>& asset_mapping) {
+    
+    std::unordered_map<std::string, int> asset_vars;
+    for (const auto& pair : asset_mapping) {
+        asset_vars[pair.second] = pair.first;
+    }
+    return asset_vars;
+}
+
+std::vector<int> ConflictAnalyzer::encodeWithSelectors(
+    SatSolver& solver,
+    const std::vector<ClauseInfo>& clauses,
+    const std::unordered_map<std::string, int>& asset_vars) {
+    
+    CnfEncoder encoder(solver, asset_vars);
+    std::vector<int> selectors;
+    for (const auto& clause : clauses) {
+        int selector = solver.newVar();
+        encoder.addConstraint(clause.expr, selector);
+        selectors.push_back(selector);
+    }
+    return selectors;
 }
 
 std::string ConflictAnalyzer::formatClauseDescription(
@@ -157,40 +412,29 @@ std::string ConflictAnalyzer::formatClauseDescription(
 
 std::string ConflictAnalyzer::generateConflictReport(
     const std::vector<std::string>& conflicting_clauses,
+    const std::vector<ClauseInfo>& clauses,
     const std::unordered_map<int, std::string>& asset_mapping) {
     
-    if (conflicting_clauses.empty()) {
+    if (conflicting_clauses.empty() && clauses.empty()) {
         return "No conflicts detected.";
     }
     
-    // Check if we have actual conflicts or just informational messages
-    bool has_actual_conflicts = false;
-    for (const auto& clause : conflicting_clauses) {
-        if (clause.find("No direct explicit contradictions") == std::string::npos &&
-            clause.find("Unsatisfiability may be due to") == std::string::npos &&
-            clause.find("Consider reviewing") == std::string::npos) {
-            has_actual_conflicts = true;
-            break;
-        }
-    }
-    
     std::string report = "Error: Unsatisfiable clauses detected\n\n";
     
-    if (has_actual_conflicts) {
+    if (!conflicting_clauses.empty()) {
         report += "Minimal conflicting set:\n";
         for (size_t i = 0; i < conflicting_clauses.size(); ++i) {
             report += "  " + std::to_string(i + 1) + ". " + conflicting_clauses[i] + "\n";
         }
         
-        // Add assets involved
+        // Add assets involved, collected from the expressions of the clauses in
+        // the set, since a description such as "binary_op" need not name them
+        std::unordered_map<std::string, int> asset_vars = invertAssetMapping(asset_mapping);
+        std::set<std::string> in_set(conflicting_clauses.begin(), conflicting_clauses.end());
         std::set<int> involved_assets;
-        for (const auto& clause_desc : conflicting_clauses) {
-            // Extract asset IDs from clause descriptions
-            // This is a simplified extraction - could be made more robust
-            for (const auto& asset_pair : asset_mapping) {
-                if (clause_desc.find(asset_pair.second) != std::string::npos) {
-                    involved_assets.insert(asset_pair.first);
-                }
+        for (const auto& clause : clauses) {
+            if (in_set.count(formatClauseDescription(clause, asset_mapping))) {
+                collectAssets(clause.expr, asset_vars, involved_assets);
             }
         }
         
@@ -204,15 +448,56 @@ std::string ConflictAnalyzer::generateConflictReport(
             }
         }
         
-        report += "\nSuggestion: Review conflicting obligations in your contract specification.";
-    } else {
-        report += "Analysis Results:\n";
-        for (size_t i = 0; i < conflicting_clauses.size(); ++i) {
-            report += "  " + std::to_string(i + 1) + ". " + conflicting_clauses[i] + "\n";
+        report += "\n";
+    }
+    
+    Relaxation relaxation = findCheapestRelaxation(clauses, asset_mapping);
+    if (relaxation.optimal) {
+        report += "Cheapest relaxation (weight " + std::to_string(relaxation.relaxed_weight) +
+                  " of " + std::to_string(relaxation.total_weight) + "):\n";
+        report += "  Drop or renegotiate:\n";
+        for (size_t i = 0; i < relaxation.relaxed.size(); ++i) {
+            const ClauseInfo& clause = clauses[relaxation.relaxed[i]];
+            report += "    " + std::to_string(i + 1) + ". " + formatClauseDescription(clause, asset_mapping) +
+                      " (weight " + std::to_string(clause.weight) + ")\n";
+        }
+        
+        report += "  Assignment satisfying the remaining clauses: [";
+        for (size_t i = 0; i < relaxation.assignment.size(); ++i) {
+            int lit = relaxation.assignment[i];
+            if (i > 0) report += ", ";
+            report += (lit > 0 ? "+" : "") + std::to_string(lit);
+        }
+        report += "]\n";
+        for (int lit : relaxation.assignment) {
+            auto it = asset_mapping.find(std::abs(lit));
+            if (it != asset_mapping.end()) {
+                report += "    " + it->second + " = " + (lit > 0 ? "true" : "false") + "\n";
+            }
         }
-        report += "\nSuggestion: The system is unsatisfiable due to complex logical interactions. Consider simplifying clause dependencies or reviewing the overall contract structure.";
+        report += "\n";
     }
     
+    if (localize_earliest) {
+        size_t earliest = findEarliestConflict(clauses, asset_mapping);
+        if (earliest < clauses.size()) {
+            const ClauseInfo& clause = clauses[earliest];
+            report += "Earliest conflict: " + formatClauseDescription(clause, asset_mapping);
+            if (clause.line > 0) {
+                report += " at line " + std::to_string(clause.line) + ", column " + std::to_string(clause.column);
+            }
+            if (earliest == 0) {
+                report += "\n  The first clause of the block is unsatisfiable on its own\n\n";
+            } else {
+                report += "\n  Clauses 1-" + std::to_string(earliest) + " of " + std::to_string(clauses.size()) +
+                          " are satisfiable together; adding clause " + std::to_string(earliest + 1) +
+                          " makes the block unsatisfiable\n\n";
+            }
+        }
+    }
+    
+    report += "Suggestion: Review conflicting obligations in your contract specification.";
+    
     return report;
 }
 
@@ -5,7 +5,7 @@
 
 namespace witness {
 
-Driver::Driver() : lexer(nullptr), program(nullptr), analyzer(std::make_unique<SemanticAnalyzer>()), solverMode("exhaustive"), verbose(false), quiet(false) {}
+Driver::Driver() : lexer(nullptr), program(nullptr), analyzer(std::make_unique<SemanticAnalyzer>()), solverMode("exhaustive"), modelsMode("all"), modelsPageOffset(0), modelsPageCount(0), conflictBudget(0.0), earliestConflict(false), backboneMode(false), marginalsMode(false), lintRedundant(false), clauseImpact(false), suggestJoins(false), partiesMode(false), verbose(false), quiet(false) {}
 
 Driver::~Driver() {
     // unique_ptr handles cleanup automatically
@@ -42,6 +42,10 @@ Program* Driver::get_program() const {
     return program.get();
 }
 
+SemanticAnalyzer* Driver::get_analyzer() const {
+    return analyzer.get();
+}
+
 void Driver::analyze() {
     if (!program) {
         std::cerr << "Error: No program to analyze" << std::endl;
@@ -55,6 +59,21 @@ void Driver::analyze() {
     
     // Pass solver mode and verbosity settings to semantic analyzer
     analyzer->setSolverMode(solverMode);
+    analyzer->setModelsMode(modelsMode);
+    analyzer->setModelsPage(modelsPageOffset, modelsPageCount);
+    analyzer->setOptimizeQuery(optimizeQuery);
+    analyzer->setConflictBudget(conflictBudget);
+    analyzer->setEarliestConflict(earliestConflict);
+    analyzer->setBackboneMode(backboneMode);
+    analyzer->setMarginalsMode(marginalsMode);
+    analyzer->setAssetLikelihoods(assetLikelihoods);
+    analyzer->setLintRedundant(lintRedundant);
+    analyzer->setClauseImpact(clauseImpact);
+    analyzer->setSuggestJoins(suggestJoins);
+    analyzer->setPartiesMode(partiesMode);
+    analyzer->addActionDictionary(actionPatterns);
+    analyzer->setLitisQueries(litisQueries);
+    analyzer->setAttributeQueries(attributeQueries);
     analyzer->setVerbose(verbose);
     analyzer->setQuiet(quiet);
     
@@ -82,6 +101,107 @@ std::string Driver::getSolverMode() const {
     return solverMode;
 }
 
+void Driver::setModelsMode(const std::string& mode) {
+    modelsMode = mode;
+}
+
+std::string Driver::getModelsMode() const {
+    return modelsMode;
+}
+
+void Driver::setModelsPage(uint64_t offset, size_t count) {
+    modelsPageOffset = offset;
+    modelsPageCount = count;
+}
+
+void Driver::setOptimizeQuery(const std::string& query) {
+    optimizeQuery = query;
+}
+
+std::string Driver::getOptimizeQuery() const {
+    return optimizeQuery;
+}
+
+void Driver::setConflictBudget(double seconds) {
+    conflictBudget = seconds;
+}
+
+double Driver::getConflictBudget() const {
+    return conflictBudget;
+}
+
+void Driver::setEarliestConflict(bool enabled) {
+    earliestConflict = enabled;
+}
+
+bool Driver::getEarliestConflict() const {
+    return earliestConflict;
+}
+
+void Driver::setBackboneMode(bool enabled) {
+    backboneMode = enabled;
+}
+
+bool Driver::getBackboneMode() const {
+    return backboneMode;
+}
+
+void Driver::setMarginalsMode(bool enabled) {
+    marginalsMode = enabled;
+}
+
+bool Driver::getMarginalsMode() const {
+    return marginalsMode;
+}
+
+void Driver::setAssetLikelihoods(const std::string& spec) {
+    assetLikelihoods = spec;
+}
+
+void Driver::setLintRedundant(bool enabled) {
+    lintRedundant = enabled;
+}
+
+bool Driver::getLintRedundant() const {
+    return lintRedundant;
+}
+
+void Driver::setClauseImpact(bool enabled) {
+    clauseImpact = enabled;
+}
+
+bool Driver::getClauseImpact() const {
+    return clauseImpact;
+}
+
+void Driver::setSuggestJoins(bool enabled) {
+    suggestJoins = enabled;
+}
+
+bool Driver::getSuggestJoins() const {
+    return suggestJoins;
+}
+
+void Driver::setPartiesMode(bool enabled) {
+    partiesMode = enabled;
+}
+
+bool Driver::getPartiesMode() const {
+    return partiesMode;
+}
+
+void Driver::setActionDictionary(const std::vector<ActionPattern>& patterns) {
+    actionPatterns = patterns;
+}
+
+void Driver::setLitisQueries(const std::vector<std::vector<std::string>>& queries) {
+    litisQueries = queries;
+}
+
+void Driver::setAttributeQueries(const std::vector<ConceptLattice::Attributes>& queries) {
+    attributeQueries = queries;
+}
+
 void Driver::setVerbose(bool v) {
     verbose = v;
 }
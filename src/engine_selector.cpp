@@ -0,0 +1,284 @@
+#include "engine_selector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+
+namespace witness {
+
+namespace {
+
+// Clauses wider than this are treated as general (no class) to keep profiling cheap
+const int kMaxClassArity = 10;
+
+// Fixed cost of spawning the external solver process and moving data through JSON
+const double kExternalOverhead = 1e7;
+
+// Exhaustive enumeration uses int bit shifts and cannot go past 30 assets
+const int kMaxExhaustiveAssets = 30;
+
+int findRoot(std::vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+std::vector<char> membership(const ClauseTable& table) {
+    std::vector<char> member(size_t(1) << table.asset_ids.size(), 0);
+    for (uint32_t m : table.models) {
+        member[m] = 1;
+    }
+    return member;
+}
+
+} // namespace
+
+bool EngineSelector::isBijunctive(const ClauseTable& table) {
+    int arity = static_cast<int>(table.asset_ids.size());
+    if (!table.complete || arity > kMaxClassArity) return false;
+    if (arity <= 2 || table.models.empty()) return true;
+
+    // Collect every unit and binary clause implied by the models, then check
+    // that they admit no extra assignments (a relation is 2-CNF iff this holds)
+    std::vector<std::pair<int, int>> implied;  // Literals as (index << 1 | negated)
+    for (int i = 0; i < 2 * arity; i++) {
+        for (int j = i; j < 2 * arity; j++) {
+            bool holds = true;
+            for (uint32_t m : table.models) {
+                bool li = ((m >> (i >> 1)) & 1) != static_cast<uint32_t>(i & 1);
+                bool lj = ((m >> (j >> 1)) & 1) != static_cast<uint32_t>(j & 1);
+                if (!li && !lj) {
+                    holds = false;
+                    break;
+                }
+            }
+            if (holds) implied.push_back({i, j});
+        }
+    }
+
+    size_t closure_size = 0;
+    for (uint32_t m = 0; m < (uint32_t(1) << arity); m++) {
+        bool satisfies = true;
+        for (const auto& clause : implied) {
+            bool li = ((m >> (clause.first >> 1)) & 1) != static_cast<uint32_t>(clause.first & 1);
+            bool lj = ((m >> (clause.second >> 1)) & 1) != static_cast<uint32_t>(clause.second & 1);
+            if (!li && !lj) {
+                satisfies = false;
+                break;
+            }
+        }
+        if (satisfies) closure_size++;
+    }
+    return closure_size == table.models.size();
+}
+
+bool EngineSelector::isHorn(const ClauseTable& table) {
+    int arity = static_cast<int>(table.asset_ids.size());
+    if (!table.complete || arity > kMaxClassArity) return false;
+
+    // Horn relations are exactly those closed under bitwise AND
+    std::vector<char> member = membership(table);
+    for (uint32_t a : table.models) {
+        for (uint32_t b : table.models) {
+            if (!member[a & b]) return false;
+        }
+    }
+    return true;
+}
+
+bool EngineSelector::isAffine(const ClauseTable& table) {
+    int arity = static_cast<int>(table.asset_ids.size());
+    if (!table.complete || arity > kMaxClassArity) return false;
+    if (table.models.empty()) return true;
+
+    // Affine relations are cosets of a linear subspace: closed under a ^ b ^ c
+    std::vector<char> member = membership(table);
+    uint32_t base = table.models[0];
+    for (uint32_t a : table.models) {
+        for (uint32_t b : table.models) {
+            if (!member[a ^ b ^ base]) return false;
+        }
+    }
+    return true;
+}
+
+int EngineSelector::estimateTreewidth(const std::vector<ClauseTable>& tables, const std::vector<int>& assets) {
+    std::unordered_map<int, int> index;
+    for (size_t i = 0; i < assets.size(); i++) {
+        index[assets[i]] = static_cast<int>(i);
+    }
+
+    std::vector<std::set<int>> adjacency(assets.size());
+    for (const auto& table : tables) {
+        for (size_t i = 0; i < table.asset_ids.size(); i++) {
+            for (size_t j = i + 1; j < table.asset_ids.size(); j++) {
+                int a = index[table.asset_ids[i]];
+                int b = index[table.asset_ids[j]];
+                adjacency[a].insert(b);
+                adjacency[b].insert(a);
+            }
+        }
+    }
+
+    // Greedy min-degree elimination; the largest eliminated degree bounds the treewidth
+    std::set<std::pair<int, int>> queue;
+    for (size_t v = 0; v < adjacency.size(); v++) {
+        queue.insert({static_cast<int>(adjacency[v].size()), static_cast<int>(v)});
+    }
+    int width = 0;
+    while (!queue.empty()) {
+        int v = queue.begin()->second;
+        queue.erase(queue.begin());
+        width = std::max(width, static_cast<int>(adjacency[v].size()));
+
+        std::vector<int> neighbours(adjacency[v].begin(), adjacency[v].end());
+        for (int u : neighbours) {
+            queue.erase({static_cast<int>(adjacency[u].size()), u});
+            adjacency[u].erase(v);
+        }
+        for (size_t i = 0; i < neighbours.size(); i++) {
+            for (size_t j = i + 1; j < neighbours.size(); j++) {
+                adjacency[neighbours[i]].insert(neighbours[j]);
+                adjacency[neighbours[j]].insert(neighbours[i]);
+            }
+        }
+        for (int u : neighbours) {
+            queue.insert({static_cast<int>(adjacency[u].size()), u});
+        }
+        adjacency[v].clear();
+    }
+    return width;
+}
+
+BlockProfile EngineSelector::profile(const std::vector<ClauseTable>& tables) const {
+    BlockProfile profile;
+    profile.num_clauses = static_cast<int>(tables.size());
+
+    std::set<int> asset_set;
+    for (const auto& table : tables) {
+        asset_set.insert(table.asset_ids.begin(), table.asset_ids.end());
+    }
+    std::vector<int> assets(asset_set.begin(), asset_set.end());
+    profile.num_assets = static_cast<int>(assets.size());
+    profile.log2_models = profile.num_assets;
+
+    std::unordered_map<int, int> index;
+    for (size_t i = 0; i < assets.size(); i++) {
+        index[assets[i]] = static_cast<int>(i);
+    }
+    std::vector<int> parent(assets.size());
+    std::iota(parent.begin(), parent.end(), 0);
+
+    for (const auto& table : tables) {
+        int arity = static_cast<int>(table.asset_ids.size());
+        profile.arity_histogram[arity]++;
+        profile.formula_size += arity + 1;
+
+        if (isBijunctive(table)) profile.two_sat_clauses++;
+        if (isHorn(table)) profile.horn_clauses++;
+        if (isAffine(table)) profile.xor_clauses++;
+
+        if (table.complete) {
+            if (table.models.empty()) {
+                profile.log2_models = -INFINITY;
+            } else {
+                profile.log2_models += std::log2(static_cast<double>(table.models.size())) - arity;
+            }
+        }
+
+        for (int i = 1; i < arity; i++) {
+            int a = findRoot(parent, index[table.asset_ids[0]]);
+            int b = findRoot(parent, index[table.asset_ids[i]]);
+            if (a != b) parent[a] = b;
+        }
+    }
+    profile.log2_models = std::max(profile.log2_models, -1.0);
+
+    std::unordered_map<int, int> component_sizes;
+    for (size_t i = 0; i < assets.size(); i++) {
+        component_sizes[findRoot(parent, static_cast<int>(i))]++;
+    }
+    profile.components = static_cast<int>(component_sizes.size());
+    for (const auto& pair : component_sizes) {
+        profile.largest_component = std::max(profile.largest_component, pair.second);
+    }
+    profile.treewidth_estimate = estimateTreewidth(tables, assets);
+
+    return profile;
+}
+
+std::vector<EngineEstimate> EngineSelector::estimate(const BlockProfile& profile, bool external_available) const {
+    std::vector<EngineEstimate> estimates;
+    double n = profile.num_assets;
+    double m = std::max(profile.num_clauses, 1);
+    double models = std::pow(2.0, std::min(profile.log2_models, n));
+
+    // Exhaustive: every assignment evaluates every clause
+    EngineEstimate exhaustive;
+    exhaustive.engine = "exhaustive";
+    exhaustive.available = profile.num_assets <= kMaxExhaustiveAssets;
+    exhaustive.cost = std::pow(2.0, n) * m;
+    estimates.push_back(exhaustive);
+
+    // SAT enumeration: one solver call per model plus the final refutation.
+    // 2-SAT and Horn blocks propagate without search; otherwise search is
+    // bounded by the treewidth of the primal graph.
+    EngineEstimate sat;
+    sat.engine = "sat";
+    sat.available = true;
+    double per_call = static_cast<double>(profile.formula_size) + n;
+    if (!profile.isTwoSat() && !profile.isHorn()) {
+        per_call *= std::pow(2.0, std::min(profile.treewidth_estimate, profile.largest_component));
+    }
+    sat.cost = 10.0 * profile.formula_size + (models + 1.0) * per_call;
+    estimates.push_back(sat);
+
+    // External tree fold: per-clause tables plus pairwise folding of partial results
+    EngineEstimate external;
+    external.engine = "external";
+    external.available = external_available;
+    double table_size = 0.0;
+    for (const auto& pair : profile.arity_histogram) {
+        table_size += pair.second * std::pow(2.0, std::min(pair.first, EngineSelector::kMaxTableArity));
+    }
+    external.cost = kExternalOverhead + table_size + m * models * std::max(n, 1.0);
+    estimates.push_back(external);
+
+    return estimates;
+}
+
+EngineEstimate EngineSelector::select(const BlockProfile& profile, bool external_available) const {
+    EngineEstimate best;
+    for (const auto& candidate : estimate(profile, external_available)) {
+        if (!candidate.available) continue;
+        if (best.engine.empty() || candidate.cost < best.cost) {
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+std::string EngineSelector::describe(const BlockProfile& profile) {
+    std::ostringstream out;
+    out << profile.num_assets << " assets, " << profile.num_clauses << " clauses, arity {";
+    bool first = true;
+    for (const auto& pair : profile.arity_histogram) {
+        if (!first) out << ", ";
+        out << pair.first << ":" << pair.second;
+        first = false;
+    }
+    out << "}, classes 2-SAT=" << profile.two_sat_clauses
+        << " Horn=" << profile.horn_clauses
+        << " XOR=" << profile.xor_clauses
+        << ", " << profile.components << " component(s) (largest " << profile.largest_component << ")"
+        << ", treewidth <= " << profile.treewidth_estimate;
+    out.precision(3);
+    out << ", ~2^" << profile.log2_models << " models";
+    return out.str();
+}
+
+} // namespace witness
@@ -0,0 +1,199 @@
+#include "equivalence_checker.hpp"
+#include "cnf_encoder.hpp"
+#include "sat_solver.hpp"
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace witness {
+
+namespace {
+
+std::string formatComponents(const std::vector<std::string>& components) {
+    std::string text = "(";
+    for (size_t i = 0; i < components.size(); i++) {
+        if (i > 0) text += ", ";
+        text += components[i];
+    }
+    return text + ")";
+}
+
+// Literal equivalent to the conjunction of the clauses
+int encodeConjunction(SatSolver& solver, CnfEncoder& encoder, const std::vector<ClauseInfo>& clauses) {
+    int conjunction = solver.newVar();
+    std::vector<int> all_hold = {conjunction};
+    for (const auto& clause : clauses) {
+        int lit = encoder.encode(clause.expr);
+        solver.addClause({-conjunction, lit});
+        all_hold.push_back(-lit);
+    }
+    solver.addClause(all_hold);
+    return conjunction;
+}
+
+} // namespace
+
+EquivalenceChecker::EquivalenceChecker(const ContractVersion& old_version, const ContractVersion& new_version) {
+    // Every asset name either version mentions, in a stable order
+    std::set<std::string> old_names;
+    std::set<std::string> new_names;
+    for (const auto& pair : old_version.asset_components) old_names.insert(pair.first);
+    for (const auto& pair : new_version.asset_components) new_names.insert(pair.first);
+    for (const auto& block : old_version.blocks) {
+        for (const auto& clause : block.clauses) {
+            std::vector<std::string> names;
+            collectNames(clause.expr, names);
+            old_names.insert(names.begin(), names.end());
+        }
+    }
+    for (const auto& block : new_version.blocks) {
+        for (const auto& clause : block.clauses) {
+            std::vector<std::string> names;
+            collectNames(clause.expr, names);
+            new_names.insert(names.begin(), names.end());
+        }
+    }
+    auto componentsOf = [](const ContractVersion& version, const std::string& name) {
+        auto it = version.asset_components.find(name);
+        return it != version.asset_components.end() ? it->second : std::vector<std::string>();
+    };
+
+    // Same name: same variable, noting component changes
+    for (const auto& name : old_names) {
+        if (!new_names.count(name)) continue;
+        int var = addVariable(name);
+        old_vars[name] = var;
+        new_vars[name] = var;
+        auto before = componentsOf(old_version, name);
+        auto after = componentsOf(new_version, name);
+        if (!before.empty() && !after.empty() && before != after) {
+            notes.push_back("asset '" + name + "' changes components " + formatComponents(before) +
+                            " -> " + formatComponents(after));
+        }
+    }
+
+    // Renamed assets: unmatched names with the same (subject, action, object)
+    std::map<std::vector<std::string>, std::vector<std::string>> unmatched_new;
+    for (const auto& name : new_names) {
+        auto components = componentsOf(new_version, name);
+        if (!new_vars.count(name) && components.size() >= 3) {
+            unmatched_new[components].push_back(name);
+        }
+    }
+    for (const auto& name : old_names) {
+        if (old_vars.count(name)) continue;
+        auto components = componentsOf(old_version, name);
+        auto it = unmatched_new.find(components);
+        if (components.size() < 3 || it == unmatched_new.end() || it->second.empty()) continue;
+        std::string new_name = it->second.front();
+        it->second.erase(it->second.begin());
+        int var = addVariable(name + "/" + new_name);
+        old_vars[name] = var;
+        new_vars[new_name] = var;
+        notes.push_back("asset '" + name + "' renamed to '" + new_name + "' " + formatComponents(components));
+    }
+
+    // The rest exist in one version only and are unconstrained in the other
+    for (const auto& name : old_names) {
+        if (old_vars.count(name)) continue;
+        old_vars[name] = addVariable(name);
+        notes.push_back("asset '" + name + "' only in " + old_version.filename);
+    }
+    for (const auto& name : new_names) {
+        if (new_vars.count(name)) continue;
+        new_vars[name] = addVariable(name);
+        notes.push_back("asset '" + name + "' only in " + new_version.filename);
+    }
+}
+
+int EquivalenceChecker::addVariable(const std::string& display_name) {
+    var_names.push_back(display_name);
+    return static_cast<int>(var_names.size());
+}
+
+void EquivalenceChecker::collectNames(Expression* expr, std::vector<std::string>& names) {
+    if (!expr) return;
+
+    if (auto identifier = dynamic_cast<Identifier*>(expr)) {
+        names.push_back(identifier->name);
+    } else if (auto func_call = dynamic_cast<FunctionCallExpression*>(expr)) {
+        if (func_call->arguments) {
+            for (const auto& arg : func_call->arguments->expressions) {
+                collectNames(arg.get(), names);
+            }
+        }
+    } else if (auto binary_op = dynamic_cast<BinaryOpExpression*>(expr)) {
+        collectNames(binary_op->left.get(), names);
+        collectNames(binary_op->right.get(), names);
+    } else if (auto unary_op = dynamic_cast<UnaryOpExpression*>(expr)) {
+        collectNames(unary_op->operand.get(), names);
+    }
+}
+
+EquivalenceResult EquivalenceChecker::compare(const std::vector<ClauseInfo>& old_clauses,
+                                              const std::vector<ClauseInfo>& new_clauses) const {
+    EquivalenceResult result;
+
+    // Miter: one literal per version on a shared solver
+    SatSolver solver;
+    solver.reserveVars(static_cast<int>(var_names.size()));
+    CnfEncoder old_encoder(solver, old_vars);
+    CnfEncoder new_encoder(solver, new_vars);
+    int old_holds = encodeConjunction(solver, old_encoder, old_clauses);
+    int new_holds = encodeConjunction(solver, new_encoder, new_clauses);
+
+    // Report distinguishing assignments over the assets the two clause sets mention
+    std::set<int> mentioned;
+    for (const auto& clause : old_clauses) {
+        std::vector<std::string> names;
+        collectNames(clause.expr, names);
+        for (const auto& name : names) mentioned.insert(old_vars.at(name));
+    }
+    for (const auto& clause : new_clauses) {
+        std::vector<std::string> names;
+        collectNames(clause.expr, names);
+        for (const auto& name : names) mentioned.insert(new_vars.at(name));
+    }
+    auto outcome = [&]() {
+        std::vector<std::pair<std::string, bool>> assignment;
+        for (int var : mentioned) {
+            assignment.push_back({var_names[var - 1], solver.modelValue(var)});
+        }
+        return assignment;
+    };
+
+    if (solver.solve({old_holds, -new_holds}) == SatSolver::Result::Satisfiable) {
+        result.only_old = outcome();
+    } else {
+        result.old_in_new = true;
+    }
+    if (solver.solve({new_holds, -old_holds}) == SatSolver::Result::Satisfiable) {
+        result.only_new = outcome();
+    } else {
+        result.new_in_old = true;
+    }
+    return result;
+}
+
+std::string EquivalenceChecker::describe(const EquivalenceResult& result) {
+    if (result.old_in_new && result.new_in_old) {
+        return "EQUIVALENT: both versions admit exactly the same outcomes";
+    }
+    if (result.new_in_old) {
+        return "REFINEMENT: the new version admits a strict subset of the old outcomes";
+    }
+    if (result.old_in_new) {
+        return "RELAXATION: the new version admits a strict superset of the old outcomes";
+    }
+    return "DIFFERENT: each version admits outcomes the other rules out";
+}
+
+std::vector<ClauseInfo> EquivalenceChecker::allClauses(const ContractVersion& version) {
+    std::vector<ClauseInfo> clauses;
+    for (const auto& block : version.blocks) {
+        clauses.insert(clauses.end(), block.clauses.begin(), block.clauses.end());
+    }
+    return clauses;
+}
+
+} // namespace witness
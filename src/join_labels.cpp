@@ -0,0 +1,131 @@
+#include "join_labels.hpp"
+
+namespace witness {
+
+namespace {
+
+const uint64_t kModulus = (uint64_t(1) << 61) - 1;
+const uint64_t kBase = 1000003;
+
+uint64_t mulMod(uint64_t a, uint64_t b) {
+    unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    uint64_t folded = static_cast<uint64_t>(product & kModulus) + static_cast<uint64_t>(product >> 61);
+    return folded >= kModulus ? folded - kModulus : folded;
+}
+
+uint64_t addMod(uint64_t a, uint64_t b) {
+    uint64_t sum = a + b;
+    return sum >= kModulus ? sum - kModulus : sum;
+}
+
+} // namespace
+
+JoinLabels::Fingerprint JoinLabels::fingerprint(const std::string& text) {
+    Fingerprint print;
+    for (unsigned char c : text) {
+        print.hash = addMod(mulMod(print.hash, kBase), c + 1);
+        print.power = mulMod(print.power, kBase);
+    }
+    print.length = text.size();
+    return print;
+}
+
+JoinLabels::Fingerprint JoinLabels::concat(const Fingerprint& a, const Fingerprint& b) {
+    Fingerprint print;
+    print.hash = addMod(mulMod(a.hash, b.power), b.hash);
+    print.power = mulMod(a.power, b.power);
+    print.length = a.length + b.length;
+    return print;
+}
+
+int JoinLabels::add(Label label) {
+    int id = static_cast<int>(labels.size());
+    by_hash.emplace(label.print.hash, id);
+    labels.push_back(std::move(label));
+    return id;
+}
+
+int JoinLabels::intern(const std::string& text) {
+    int existing = find(text);
+    if (existing >= 0) return existing;
+
+    Label label;
+    label.text = text;
+    label.print = fingerprint(text);
+    return add(std::move(label));
+}
+
+int JoinLabels::join(const std::string& prefix, int left, int right) {
+    static const Fingerprint separator = fingerprint("_");
+    Fingerprint print = concat(concat(concat(fingerprint(prefix), labels[left].print), separator), labels[right].print);
+
+    // The same join of the same labels is found without spelling anything
+    // out; a different construction of the same text is compared in full
+    auto range = by_hash.equal_range(print.hash);
+    std::string spelled;
+    for (auto it = range.first; it != range.second; ++it) {
+        const Label& candidate = labels[it->second];
+        if (candidate.print.length != print.length) continue;
+        if (candidate.left == left && candidate.right == right && candidate.prefix == prefix) {
+            return it->second;
+        }
+        if (spelled.empty()) spelled = prefix + text(left) + "_" + text(right);
+        if (text(it->second) == spelled) return it->second;
+    }
+
+    Label label;
+    label.prefix = prefix;
+    label.left = left;
+    label.right = right;
+    label.print = print;
+    return add(std::move(label));
+}
+
+int JoinLabels::find(const std::string& text) const {
+    Fingerprint print = fingerprint(text);
+    auto range = by_hash.equal_range(print.hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (matches(it->second, text)) return it->second;
+    }
+    return -1;
+}
+
+bool JoinLabels::matches(int id, const std::string& text) const {
+    const Label& label = labels[id];
+    if (label.print.length != text.size()) return false;
+    return label.left < 0 ? label.text == text : this->text(id) == text;
+}
+
+std::string JoinLabels::text(int id) const {
+    std::string spelled;
+    spelled.reserve(labels[id].print.length);
+
+    // An explicit stack, since a chain of joins nests as deep as it is long;
+    // -1 stands for the '_' between two operands
+    std::vector<int> pending = {id};
+    while (!pending.empty()) {
+        int next = pending.back();
+        pending.pop_back();
+        if (next < 0) {
+            spelled += '_';
+            continue;
+        }
+        const Label& label = labels[next];
+        if (label.left < 0) {
+            spelled += label.text;
+            continue;
+        }
+        spelled += label.prefix;
+        pending.push_back(label.right);
+        pending.push_back(-1);
+        pending.push_back(label.left);
+    }
+    return spelled;
+}
+
+void JoinLabels::clear() {
+    labels.clear();
+    by_hash.clear();
+}
+
+} // namespace witness
@@ -1,18 +1,140 @@
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "driver.hpp"
+#include "equivalence_checker.hpp"
+#include "optimize_query.hpp"
 
 void printUsage(const char* programName) {
     std::cerr << "Usage: " << programName << " [options] <filename>" << std::endl;
+    std::cerr << "       " << programName << " --equiv|--equiv-blocks <old.wit> <new.wit>" << std::endl;
     std::cerr << "Options:" << std::endl;
-    std::cerr << "  --solver=exhaustive|external  Solver mode (default: exhaustive)" << std::endl;
+    std::cerr << "  --solver=MODE                Solver mode: exhaustive (default), external, sat, auto, portfolio" << std::endl;
+    std::cerr << "  --models=all|minimal         Report all models or only subset-minimal ones (default: all)" << std::endl;
+    std::cerr << "  --models-page=OFFSET:COUNT   Report COUNT models from OFFSET in truth table order" << std::endl;
+    std::cerr << "  --optimize=min|max[:TERMS]   Report one optimal model; TERMS like subject=NAME@W,assets" << std::endl;
+    std::cerr << "  --backbone                   Report assets forced true or false in every model of a block" << std::endl;
+    std::cerr << "  --marginals[=NAME@P,...]     Report per-asset model counts, weighted by asset likelihoods" << std::endl;
+    std::cerr << "  --lint-redundant             Report clauses implied by their block, tautological or contradictory" << std::endl;
+    std::cerr << "  --clause-impact              Rank clauses by the models their removal adds" << std::endl;
+    std::cerr << "  --suggest-joins              Report every valid contextual join between reciprocal assets" << std::endl;
+    std::cerr << "  --parties                    Project every global() block onto each subject, in parallel" << std::endl;
+    std::cerr << "  --action-dictionary=FILE     Add keywords for inferring action types (repeatable)" << std::endl;
+    std::cerr << "  --queries=FILE               Check each line's assets as a litis() query against every global() block" << std::endl;
+    std::cerr << "  --assets-with=ROLE=VALUE,... List assets sharing components, e.g. subject=alice,object=bob (repeatable)" << std::endl;
+    std::cerr << "  --all-conflicts[=SECONDS]    On conflicts, enumerate every MUS and MCS (default budget: 10s)" << std::endl;
+    std::cerr << "  --earliest-conflict          On conflicts, report the first clause in source order that causes one" << std::endl;
+    std::cerr << "  --equiv                      Compare the outcomes admitted by two versions of a contract" << std::endl;
+    std::cerr << "  --equiv-blocks               Same, comparing global()/litis() blocks pairwise" << std::endl;
     std::cerr << "  --verbose                    Show detailed output (AST, warnings, debug info)" << std::endl;
     std::cerr << "  --quiet                      Suppress all non-error output" << std::endl;
 }
 
+// Parse and analyze one contract version, collecting its clause blocks without solving them
+bool loadContractVersion(witness::Driver& driver, const std::string& filename, witness::ContractVersion& version) {
+    driver.setQuiet(true);
+    if (driver.parse(filename) != 0 || !driver.get_program()) {
+        std::cerr << "Error: Parsing failed for " << filename << std::endl;
+        return false;
+    }
+    witness::SemanticAnalyzer* analyzer = driver.get_analyzer();
+    analyzer->setCollectBlocksOnly(true);
+    driver.analyze();
+    for (const auto& error : analyzer->getErrors()) {
+        std::cerr << filename << ": Error: " << error << std::endl;
+    }
+
+    version.filename = filename;
+    version.blocks = analyzer->getCollectedBlocks();
+    // Declared assets, not just those the clauses use, so an asset both
+    // versions declare is aligned even when one of them never constrains it
+    for (const auto& name : analyzer->getDeclaredAssets()) {
+        version.asset_components[name] = analyzer->getAssetComponentsByName(name);
+    }
+    return true;
+}
+
+void printOutcome(const std::string& label, const std::vector<std::pair<std::string, bool>>& outcome) {
+    std::cout << "  " << label << ":";
+    for (size_t i = 0; i < outcome.size(); i++) {
+        std::cout << (i > 0 ? ", " : " ") << outcome[i].first << " = " << (outcome[i].second ? "true" : "false");
+    }
+    std::cout << std::endl;
+}
+
+int runEquivalence(const std::string& old_file, const std::string& new_file, bool block_level) {
+    witness::Driver old_driver;
+    witness::Driver new_driver;
+    witness::ContractVersion old_version;
+    witness::ContractVersion new_version;
+    if (!loadContractVersion(old_driver, old_file, old_version) ||
+        !loadContractVersion(new_driver, new_file, new_version)) {
+        return 1;
+    }
+
+    witness::EquivalenceChecker checker(old_version, new_version);
+    std::cout << "Comparing " << old_file << " -> " << new_file << std::endl;
+    for (const auto& note : checker.alignmentNotes()) {
+        std::cout << "  Note: " << note << std::endl;
+    }
+
+    auto report = [&](const std::string& label, const witness::EquivalenceResult& result) {
+        std::cout << label << ": " << witness::EquivalenceChecker::describe(result) << std::endl;
+        if (!result.only_old.empty()) printOutcome("Admitted only by " + old_file, result.only_old);
+        if (!result.only_new.empty()) printOutcome("Admitted only by " + new_file, result.only_new);
+        return result.old_in_new && result.new_in_old;
+    };
+
+    bool equivalent = true;
+    if (!block_level) {
+        equivalent = report("Contract", checker.compare(witness::EquivalenceChecker::allClauses(old_version),
+                                                        witness::EquivalenceChecker::allClauses(new_version)));
+    } else {
+        size_t num_blocks = std::max(old_version.blocks.size(), new_version.blocks.size());
+        for (size_t i = 0; i < num_blocks; i++) {
+            if (i >= old_version.blocks.size() || i >= new_version.blocks.size()) {
+                const auto& extra = i < old_version.blocks.size() ? old_version.blocks[i] : new_version.blocks[i];
+                std::cout << "Block " << (i + 1) << " (" << extra.label << "): only in "
+                          << (i < old_version.blocks.size() ? old_file : new_file) << std::endl;
+                equivalent = false;
+                continue;
+            }
+            std::string label = "Block " + std::to_string(i + 1) + " (" + old_version.blocks[i].label;
+            if (new_version.blocks[i].label != old_version.blocks[i].label) {
+                label += " vs " + new_version.blocks[i].label;
+            }
+            label += ")";
+            equivalent = report(label, checker.compare(old_version.blocks[i].clauses, new_version.blocks[i].clauses)) && equivalent;
+        }
+    }
+    return equivalent ? 0 : 2;
+}
+
 int main(int argc, char* argv[]) {
     std::string solverMode = "exhaustive"; // Default solver
+    std::string modelsMode = "all";
+    uint64_t modelsPageOffset = 0;
+    size_t modelsPageCount = 0;
+    std::string optimizeQuery;
+    double conflictBudget = 0.0;
+    bool earliestConflict = false;
+    bool backboneMode = false;
+    bool marginalsMode = false;
+    std::string assetLikelihoods;
+    bool lintRedundant = false;
+    bool clauseImpact = false;
+    bool suggestJoins = false;
+    bool partiesMode = false;
+    std::vector<witness::ActionPattern> actionPatterns;
+    std::vector<std::vector<std::string>> litisQueries;
+    std::vector<witness::ConceptLattice::Attributes> attributeQueries;
     std::string filename;
+    std::string secondFilename;
+    std::string equivMode;
     bool verbose = false;
     bool quiet = false;
     
@@ -22,11 +144,117 @@ int main(int argc, char* argv[]) {
         
         if (arg.substr(0, 9) == "--solver=") {
             solverMode = arg.substr(9);
-            if (solverMode != "exhaustive" && solverMode != "external") {
+            if (solverMode != "exhaustive" && solverMode != "external" &&
+                solverMode != "sat" && solverMode != "auto" && solverMode != "portfolio") {
                 std::cerr << "Error: Invalid solver mode '" << solverMode << "'" << std::endl;
                 printUsage(argv[0]);
                 return 1;
             }
+        } else if (arg.substr(0, 9) == "--models=") {
+            modelsMode = arg.substr(9);
+            if (modelsMode != "all" && modelsMode != "minimal") {
+                std::cerr << "Error: Invalid models mode '" << modelsMode << "'" << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg.substr(0, 14) == "--models-page=") {
+            std::string page = arg.substr(14);
+            size_t colon = page.find(':');
+            bool valid = colon != std::string::npos && colon > 0 && colon + 1 < page.size() &&
+                         page.find_first_not_of("0123456789:") == std::string::npos &&
+                         page.find(':', colon + 1) == std::string::npos;
+            if (valid) {
+                try {
+                    modelsPageOffset = std::stoull(page.substr(0, colon));
+                    modelsPageCount = std::stoull(page.substr(colon + 1));
+                } catch (const std::exception&) {
+                    valid = false;
+                }
+            }
+            if (!valid || modelsPageCount == 0) {
+                std::cerr << "Error: Invalid models page '" << page << "', expected OFFSET:COUNT" << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg.substr(0, 11) == "--optimize=") {
+            optimizeQuery = arg.substr(11);
+            witness::OptimizeQuery query;
+            std::string error;
+            if (!witness::OptimizeQuery::parse(optimizeQuery, query, error)) {
+                std::cerr << "Error: Invalid optimization query: " << error << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--backbone") {
+            backboneMode = true;
+        } else if (arg == "--marginals") {
+            marginalsMode = true;
+        } else if (arg.substr(0, 12) == "--marginals=") {
+            marginalsMode = true;
+            assetLikelihoods = arg.substr(12);
+            std::unordered_map<std::string, double> likelihoods;
+            std::string error;
+            if (!witness::SemanticAnalyzer::parseLikelihoods(assetLikelihoods, likelihoods, error)) {
+                std::cerr << "Error: Invalid asset likelihoods: " << error << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--lint-redundant") {
+            lintRedundant = true;
+        } else if (arg == "--clause-impact") {
+            clauseImpact = true;
+        } else if (arg == "--suggest-joins") {
+            suggestJoins = true;
+        } else if (arg == "--parties") {
+            partiesMode = true;
+        } else if (arg.substr(0, 20) == "--action-dictionary=") {
+            std::ifstream dictionaryFile(arg.substr(20));
+            if (!dictionaryFile) {
+                std::cerr << "Error: Cannot open action dictionary '" << arg.substr(20) << "'" << std::endl;
+                return 1;
+            }
+            std::string error;
+            if (!witness::ActionDictionary::parse(dictionaryFile, actionPatterns, error)) {
+                std::cerr << "Error: Invalid action dictionary '" << arg.substr(20) << "': " << error << std::endl;
+                return 1;
+            }
+        } else if (arg.substr(0, 10) == "--queries=") {
+            std::ifstream queryFile(arg.substr(10));
+            if (!queryFile) {
+                std::cerr << "Error: Cannot open query file '" << arg.substr(10) << "'" << std::endl;
+                return 1;
+            }
+            std::string error;
+            if (!witness::SemanticAnalyzer::parseQueries(queryFile, litisQueries, error)) {
+                std::cerr << "Error: Invalid query file: " << error << std::endl;
+                return 1;
+            }
+        } else if (arg.substr(0, 14) == "--assets-with=") {
+            witness::ConceptLattice::Attributes attributes;
+            std::string error;
+            if (!witness::ConceptLattice::parseAttributes(arg.substr(14), attributes, error)) {
+                std::cerr << "Error: Invalid component query: " << error << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+            attributeQueries.push_back(attributes);
+        } else if (arg == "--all-conflicts") {
+            conflictBudget = 10.0;
+        } else if (arg.substr(0, 16) == "--all-conflicts=") {
+            try {
+                conflictBudget = std::stod(arg.substr(16));
+            } catch (const std::exception&) {
+                conflictBudget = -1.0;
+            }
+            if (!(conflictBudget > 0)) {
+                std::cerr << "Error: Invalid conflict enumeration budget '" << arg.substr(16) << "'" << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--earliest-conflict") {
+            earliestConflict = true;
+        } else if (arg == "--equiv" || arg == "--equiv-blocks") {
+            equivMode = arg;
         } else if (arg == "--verbose") {
             verbose = true;
         } else if (arg == "--quiet") {
@@ -38,6 +266,8 @@ int main(int argc, char* argv[]) {
         } else {
             if (filename.empty()) {
                 filename = arg;
+            } else if (!equivMode.empty() && secondFilename.empty()) {
+                secondFilename = arg;
             } else {
                 std::cerr << "Error: Multiple input files specified" << std::endl;
                 printUsage(argv[0]);
@@ -46,16 +276,45 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (!optimizeQuery.empty() && modelsMode == "minimal") {
+        std::cerr << "Error: --optimize cannot be combined with --models=minimal" << std::endl;
+        return 1;
+    }
+    
     if (filename.empty()) {
         std::cerr << "Error: No input file specified" << std::endl;
         printUsage(argv[0]);
         return 1;
     }
+    
+    if (!equivMode.empty()) {
+        if (secondFilename.empty()) {
+            std::cerr << "Error: " << equivMode << " requires two input files" << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+        return runEquivalence(filename, secondFilename, equivMode == "--equiv-blocks");
+    }
 
     witness::Driver driver;
     
     // Set solver mode and verbosity in driver
     driver.setSolverMode(solverMode);
+    driver.setModelsMode(modelsMode);
+    driver.setModelsPage(modelsPageOffset, modelsPageCount);
+    driver.setOptimizeQuery(optimizeQuery);
+    driver.setConflictBudget(conflictBudget);
+    driver.setEarliestConflict(earliestConflict);
+    driver.setBackboneMode(backboneMode);
+    driver.setMarginalsMode(marginalsMode);
+    driver.setAssetLikelihoods(assetLikelihoods);
+    driver.setLintRedundant(lintRedundant);
+    driver.setClauseImpact(clauseImpact);
+    driver.setSuggestJoins(suggestJoins);
+    driver.setPartiesMode(partiesMode);
+    driver.setActionDictionary(actionPatterns);
+    driver.setLitisQueries(litisQueries);
+    driver.setAttributeQueries(attributeQueries);
     driver.setVerbose(verbose);
     driver.setQuiet(quiet);
     
@@ -0,0 +1,153 @@
+#include "maxsat_solver.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace witness {
+
+MaxSatSolver::MaxSatSolver(SatSolver& solver) : solver(solver) {}
+
+size_t MaxSatSolver::addSoft(int literal, long long weight) {
+    soft_literals.push_back(literal);
+    weights.push_back(weight);
+    return soft_literals.size() - 1;
+}
+
+MaxSatSolver::Result MaxSatSolver::solve() {
+    Result result;
+    std::unordered_map<int, size_t> index_of;
+    for (size_t i = 0; i < soft_literals.size(); i++) {
+        index_of[soft_literals[i]] = i;
+    }
+
+    for (;;) {
+        std::vector<size_t> hitting_set = minimumHittingSet();
+        std::vector<char> relaxed(soft_literals.size(), 0);
+        for (size_t i : hitting_set) {
+            relaxed[i] = 1;
+        }
+
+        std::vector<int> assumptions;
+        for (size_t i = 0; i < soft_literals.size(); i++) {
+            if (!relaxed[i]) assumptions.push_back(soft_literals[i]);
+        }
+
+        SatSolver::Result status = solver.solve(assumptions);
+        if (status == SatSolver::Result::Unknown) {
+            return result;
+        }
+        if (status == SatSolver::Result::Satisfiable) {
+            // The hitting set is a lower bound and the model falsifies at most it, so it is optimal
+            result.feasible = true;
+            result.optimal = true;
+            for (size_t i = 0; i < soft_literals.size(); i++) {
+                int lit = soft_literals[i];
+                if (solver.modelValue(std::abs(lit)) != (lit > 0)) {
+                    result.falsified.push_back(i);
+                    result.cost += weights[i];
+                }
+            }
+            return result;
+        }
+
+        std::vector<size_t> core;
+        for (int lit : solver.conflictAssumptions()) {
+            auto it = index_of.find(lit);
+            if (it != index_of.end()) core.push_back(it->second);
+        }
+        if (core.empty()) {
+            return result; // The hard clauses are unsatisfiable on their own
+        }
+        cores.push_back(trimCore(core));
+    }
+}
+
+std::vector<size_t> MaxSatSolver::trimCore(const std::vector<size_t>& core) {
+    // Re-solving under the core alone often returns a smaller one
+    std::vector<size_t> current = core;
+    for (int round = 0; round < 3 && current.size() > 1; round++) {
+        std::vector<int> assumptions;
+        for (size_t i : current) {
+            assumptions.push_back(soft_literals[i]);
+        }
+        if (solver.solve(assumptions) != SatSolver::Result::Unsatisfiable) break;
+
+        std::vector<size_t> smaller;
+        for (int lit : solver.conflictAssumptions()) {
+            for (size_t i : current) {
+                if (soft_literals[i] == lit) {
+                    smaller.push_back(i);
+                    break;
+                }
+            }
+        }
+        if (smaller.empty() || smaller.size() >= current.size()) break;
+        current = smaller;
+    }
+    return current;
+}
+
+std::vector<size_t> MaxSatSolver::minimumHittingSet() const {
+    std::vector<char> chosen(soft_literals.size(), 0);
+    std::vector<char> best(soft_literals.size(), 0);
+
+    // Greedy solution as the initial upper bound: cheapest element of every unhit core
+    long long best_cost = 0;
+    for (const auto& core : cores) {
+        bool hit = false;
+        for (size_t i : core) {
+            if (best[i]) hit = true;
+        }
+        if (hit) continue;
+        size_t cheapest = core[0];
+        for (size_t i : core) {
+            if (weights[i] < weights[cheapest]) cheapest = i;
+        }
+        best[cheapest] = 1;
+        best_cost += weights[cheapest];
+    }
+
+    searchHittingSet(chosen, 0, best_cost, best);
+
+    std::vector<size_t> hitting_set;
+    for (size_t i = 0; i < best.size(); i++) {
+        if (best[i]) hitting_set.push_back(i);
+    }
+    return hitting_set;
+}
+
+void MaxSatSolver::searchHittingSet(std::vector<char>& chosen, long long cost,
+                                    long long& best_cost, std::vector<char>& best) const {
+    // Branch on the smallest core not yet hit
+    const std::vector<size_t>* branch = nullptr;
+    for (const auto& core : cores) {
+        bool hit = false;
+        for (size_t i : core) {
+            if (chosen[i]) {
+                hit = true;
+                break;
+            }
+        }
+        if (!hit && (!branch || core.size() < branch->size())) {
+            branch = &core;
+        }
+    }
+    if (!branch) {
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = chosen;
+        }
+        return;
+    }
+
+    std::vector<size_t> order = *branch;
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return weights[a] < weights[b]; });
+    for (size_t i : order) {
+        if (cost + weights[i] >= best_cost) continue;
+        chosen[i] = 1;
+        searchHittingSet(chosen, cost + weights[i], best_cost, best);
+        chosen[i] = 0;
+    }
+}
+
+} // namespace witness
@@ -0,0 +1,124 @@
+#include "model_pager.hpp"
+#include <algorithm>
+#include <set>
+
+namespace witness {
+
+namespace {
+
+// Collect the asset names an expression mentions
+void collectNames(Expression* expr, std::set<std::string>& names) {
+    if (!expr) return;
+
+    if (auto identifier = dynamic_cast<Identifier*>(expr)) {
+        names.insert(identifier->name);
+    } else if (auto func_call = dynamic_cast<FunctionCallExpression*>(expr)) {
+        if (func_call->arguments) {
+            for (const auto& arg : func_call->arguments->expressions) {
+                collectNames(arg.get(), names);
+            }
+        }
+    } else if (auto binary_op = dynamic_cast<BinaryOpExpression*>(expr)) {
+        collectNames(binary_op->left.get(), names);
+        collectNames(binary_op->right.get(), names);
+    } else if (auto unary_op = dynamic_cast<UnaryOpExpression*>(expr)) {
+        collectNames(unary_op->operand.get(), names);
+    }
+}
+
+// Enough levels for every projected asset and every mentioned asset
+int countVariables(ClauseView clauses, const std::vector<int>& projection) {
+    std::set<std::string> names;
+    for (const auto& clause : clauses) {
+        collectNames(clause.expr, names);
+    }
+    return static_cast<int>(names.size() + projection.size());
+}
+
+} // namespace
+
+ModelPager::ModelPager(ClauseView clauses, const std::unordered_map<std::string, int>& asset_vars,
+                       const std::vector<int>& projection)
+    : asset_ids(projection), bdd(countVariables(clauses, projection)), root(Bdd::False), overflow(false) {
+    std::sort(asset_ids.begin(), asset_ids.end());
+
+    // Projected assets take the top levels, most significant (highest ID)
+    // first; the quantified assets sit below them
+    std::unordered_map<int, int> level_of_id;
+    for (int i = 0; i < depth(); i++) {
+        level_of_id[asset_ids[depth() - 1 - i]] = i;
+    }
+    std::set<std::string> names;
+    for (const auto& clause : clauses) {
+        collectNames(clause.expr, names);
+    }
+    std::unordered_map<std::string, int> var_of;
+    int next_level = depth();
+    for (const auto& name : names) {
+        auto it = asset_vars.find(name);
+        if (it == asset_vars.end()) continue;
+        auto projected = level_of_id.find(it->second);
+        var_of[name] = projected != level_of_id.end() ? projected->second : next_level++;
+    }
+
+    root = Bdd::True;
+    for (const auto& clause : clauses) {
+        root = bdd.conjoin(root, bdd.compile(clause.expr, var_of));
+    }
+    root = bdd.existsFrom(root, depth());
+    overflow = bdd.overflowed();
+    if (overflow) return;
+
+    // Bottom-up counts; node handles grow from children to parents
+    counts.assign(bdd.size(), BigCount());
+    counts[Bdd::True] = 1;
+    for (Bdd::Node node = Bdd::True + 1; node < static_cast<Bdd::Node>(bdd.size()); node++) {
+        if (levelOf(node) >= depth()) continue;
+        counts[node] = modelsFrom(bdd.low(node), levelOf(node) + 1) + modelsFrom(bdd.high(node), levelOf(node) + 1);
+    }
+    total = modelsFrom(root, 0);
+}
+
+int ModelPager::levelOf(Bdd::Node node) const {
+    return std::min(bdd.level(node), depth());
+}
+
+BigCount ModelPager::modelsFrom(Bdd::Node node, int from_level) const {
+    // Projected levels skipped between from_level and the node are free
+    return counts[node] << (levelOf(node) - from_level);
+}
+
+std::vector<int> ModelPager::model(BigCount rank) const {
+    std::vector<int> assignment(depth());
+    Bdd::Node node = root;
+    for (int level = 0; level < depth(); level++) {
+        bool branches = levelOf(node) == level;
+        Bdd::Node low = branches ? bdd.low(node) : node;
+        Bdd::Node high = branches ? bdd.high(node) : node;
+        BigCount below = modelsFrom(low, level + 1);
+
+        // False before true, as in the truth table
+        int asset_id = asset_ids[depth() - 1 - level];
+        if (rank < below) {
+            assignment[depth() - 1 - level] = -asset_id;
+            node = low;
+        } else {
+            rank -= below;
+            assignment[depth() - 1 - level] = asset_id;
+            node = high;
+        }
+    }
+    return assignment;
+}
+
+std::vector<std::vector<int>> ModelPager::page(const BigCount& offset, size_t count) const {
+    std::vector<std::vector<int>> models;
+    BigCount rank = offset;
+    for (size_t i = 0; i < count && rank < total; i++) {
+        models.push_back(model(rank));
+        rank += 1;
+    }
+    return models;
+}
+
+} // namespace witness
@@ -0,0 +1,98 @@
+#include "optimize_query.hpp"
+#include <sstream>
+
+namespace witness {
+
+bool OptimizeQuery::parse(const std::string& text, OptimizeQuery& query, std::string& error) {
+    query = OptimizeQuery();
+
+    size_t colon = text.find(':');
+    std::string direction = text.substr(0, colon);
+    if (direction == "min") {
+        query.maximize = false;
+    } else if (direction == "max") {
+        query.maximize = true;
+    } else {
+        error = "optimization direction must be 'min' or 'max', got '" + direction + "'";
+        return false;
+    }
+
+    if (colon == std::string::npos) {
+        query.terms.push_back({"assets", "", 1});
+        return true;
+    }
+
+    std::stringstream terms(text.substr(colon + 1));
+    std::string item;
+    while (std::getline(terms, item, ',')) {
+        Term term;
+        size_t at = item.find('@');
+        if (at != std::string::npos) {
+            std::string weight = item.substr(at + 1);
+            if (weight.empty() || weight.size() > 15 || weight.find_first_not_of("0123456789") != std::string::npos) {
+                error = "term weight must be a non-negative integer, got '" + weight + "'";
+                return false;
+            }
+            term.weight = std::stoll(weight);
+            item = item.substr(0, at);
+        }
+
+        size_t equals = item.find('=');
+        if (item == "assets") {
+            term.kind = "assets";
+        } else if (equals != std::string::npos) {
+            term.kind = item.substr(0, equals);
+            term.name = item.substr(equals + 1);
+            if (term.kind != "asset" && term.kind != "subject" && term.kind != "action" && term.kind != "object") {
+                error = "unknown optimization term kind '" + term.kind + "'";
+                return false;
+            }
+            if (term.name.empty()) {
+                error = "optimization term '" + item + "' has no name";
+                return false;
+            }
+        } else {
+            error = "invalid optimization term '" + item + "'";
+            return false;
+        }
+        query.terms.push_back(term);
+    }
+
+    if (query.terms.empty()) {
+        error = "optimization query has no terms";
+        return false;
+    }
+    return true;
+}
+
+long long OptimizeQuery::weightOf(const std::string& asset_name, const std::vector<std::string>& components) const {
+    long long weight = 0;
+    for (const auto& term : terms) {
+        bool matches = false;
+        if (term.kind == "assets") {
+            matches = true;
+        } else if (term.kind == "asset") {
+            matches = asset_name == term.name;
+        } else if (term.kind == "subject") {
+            matches = components.size() > 0 && components[0] == term.name;
+        } else if (term.kind == "action") {
+            matches = components.size() > 1 && components[1] == term.name;
+        } else if (term.kind == "object") {
+            matches = components.size() > 2 && components[2] == term.name;
+        }
+        if (matches) weight += term.weight;
+    }
+    return weight;
+}
+
+std::string OptimizeQuery::describe() const {
+    std::string text = maximize ? "maximize" : "minimize";
+    for (size_t i = 0; i < terms.size(); i++) {
+        text += i == 0 ? " " : " + ";
+        if (terms[i].weight != 1) text += std::to_string(terms[i].weight) + "*";
+        text += terms[i].kind == "assets" ? "assets" : terms[i].kind + "=" + terms[i].name;
+    }
+    return text;
+}
+
+} // namespace witness
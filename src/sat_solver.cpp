@@ -0,0 +1,519 @@
+#include "sat_solver.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace witness {
+
+SatSolver::SatSolver()
+    : ok(true), qhead(0), var_inc(1.0), cla_inc(1.0), max_learnts(1000.0),
+      default_polarity(false), interrupt_flag(nullptr) {
+    // Variable 0 is unused so that asset IDs map directly onto variables
+    assigns.push_back(0);
+    levels.push_back(0);
+    reasons.push_back(-1);
+    polarity.push_back(0);
+    activity.push_back(0.0);
+    seen.push_back(0);
+    heap_index.push_back(-1);
+    watches.resize(2);
+}
+
+int SatSolver::newVar() {
+    int v = static_cast<int>(assigns.size());
+    assigns.push_back(0);
+    levels.push_back(0);
+    reasons.push_back(-1);
+    polarity.push_back(default_polarity ? 1 : 0);
+    activity.push_back(0.0);
+    seen.push_back(0);
+    heap_index.push_back(-1);
+    watches.resize(2 * (v + 1));
+    heapInsert(v);
+    return v;
+}
+
+void SatSolver::reserveVars(int count) {
+    while (numVars() < count) {
+        newVar();
+    }
+}
+
+int SatSolver::numVars() const {
+    return static_cast<int>(assigns.size()) - 1;
+}
+
+bool SatSolver::okay() const {
+    return ok;
+}
+
+void SatSolver::setInterruptFlag(const std::atomic<bool>* flag) {
+    interrupt_flag = flag;
+}
+
+void SatSolver::setDefaultPolarity(bool value) {
+    default_polarity = value;
+    for (size_t v = 1; v < polarity.size(); v++) {
+        polarity[v] = value ? 1 : 0;
+    }
+}
+
+bool SatSolver::addClause(const std::vector<int>& literals) {
+    if (!ok) return false;
+
+    std::vector<int> lits;
+    lits.reserve(literals.size());
+    for (int lit : literals) {
+        if (lit == 0) continue;
+        reserveVars(std::abs(lit));
+        lits.push_back(toInternal(lit));
+    }
+    std::sort(lits.begin(), lits.end());
+
+    // Drop duplicates and literals false at level 0; skip tautologies and satisfied clauses
+    std::vector<int> simplified;
+    for (size_t i = 0; i < lits.size(); i++) {
+        if (i > 0 && lits[i] == lits[i - 1]) continue;
+        if (i > 0 && lits[i] == neg(lits[i - 1])) return true;
+        int8_t value = litValue(lits[i]);
+        if (value == 1) return true;
+        if (value == -1) continue;
+        simplified.push_back(lits[i]);
+    }
+
+    if (simplified.empty()) {
+        ok = false;
+        return false;
+    }
+    if (simplified.size() == 1) {
+        enqueue(simplified[0], -1);
+        if (propagate() != -1) {
+            ok = false;
+            return false;
+        }
+        return true;
+    }
+    attachClause(simplified, false);
+    return true;
+}
+
+int SatSolver::attachClause(const std::vector<int>& lits, bool learnt) {
+    Clause clause;
+    clause.lits = lits;
+    clause.learnt = learnt;
+    int cref = static_cast<int>(clauses.size());
+    clauses.push_back(std::move(clause));
+    watches[neg(lits[0])].push_back({cref, lits[1]});
+    watches[neg(lits[1])].push_back({cref, lits[0]});
+    if (learnt) {
+        learnts.push_back(cref);
+    }
+    return cref;
+}
+
+void SatSolver::enqueue(int lit, int reason) {
+    int v = var(lit);
+    assigns[v] = (lit & 1) ? -1 : 1;
+    levels[v] = decisionLevel();
+    reasons[v] = reason;
+    trail.push_back(lit);
+}
+
+int SatSolver::propagate() {
+    int confl = -1;
+    while (qhead < trail.size()) {
+        int p = trail[qhead++];
+        int false_lit = neg(p);
+        std::vector<Watcher>& ws = watches[p];
+        size_t i = 0, j = 0;
+        while (i < ws.size()) {
+            Watcher w = ws[i++];
+            if (litValue(w.blocker) == 1) {
+                ws[j++] = w;
+                continue;
+            }
+            std::vector<int>& c = clauses[w.cref].lits;
+            if (c[0] == false_lit) {
+                std::swap(c[0], c[1]);
+            }
+            int first = c[0];
+            if (first != w.blocker && litValue(first) == 1) {
+                ws[j++] = {w.cref, first};
+                continue;
+            }
+
+            // Look for a new literal to watch
+            bool found = false;
+            for (size_t k = 2; k < c.size(); k++) {
+                if (litValue(c[k]) != -1) {
+                    std::swap(c[1], c[k]);
+                    watches[neg(c[1])].push_back({w.cref, first});
+                    found = true;
+                    break;
+                }
+            }
+            if (found) continue;
+
+            ws[j++] = {w.cref, first};
+            if (litValue(first) == -1) {
+                confl = w.cref;
+                qhead = trail.size();
+                while (i < ws.size()) {
+                    ws[j++] = ws[i++];
+                }
+            } else {
+                enqueue(first, w.cref);
+            }
+        }
+        ws.resize(j);
+        if (confl != -1) break;
+    }
+    return confl;
+}
+
+void SatSolver::analyze(int confl, std::vector<int>& out_learnt, int& out_btlevel) {
+    int path_count = 0;
+    int p = -1;
+    out_learnt.clear();
+    out_learnt.push_back(-1);
+    int index = static_cast<int>(trail.size()) - 1;
+
+    do {
+        Clause& clause = clauses[confl];
+        if (clause.learnt) {
+            bumpClause(confl);
+        }
+        for (size_t j = (p == -1 ? 0 : 1); j < clause.lits.size(); j++) {
+            int q = clause.lits[j];
+            int v = var(q);
+            if (!seen[v] && levels[v] > 0) {
+                bumpVar(v);
+                seen[v] = 1;
+                if (levels[v] >= decisionLevel()) {
+                    path_count++;
+                } else {
+                    out_learnt.push_back(q);
+                }
+            }
+        }
+        while (!seen[var(trail[index])]) {
+            index--;
+        }
+        p = trail[index];
+        index--;
+        confl = reasons[var(p)];
+        seen[var(p)] = 0;
+        path_count--;
+    } while (path_count > 0);
+    out_learnt[0] = neg(p);
+
+    // Drop literals implied by the rest of the learnt clause
+    std::vector<int> marked(out_learnt.begin() + 1, out_learnt.end());
+    size_t keep = 1;
+    for (size_t i = 1; i < out_learnt.size(); i++) {
+        int reason = reasons[var(out_learnt[i])];
+        bool redundant = reason != -1;
+        if (redundant) {
+            const std::vector<int>& rl = clauses[reason].lits;
+            for (size_t k = 1; k < rl.size(); k++) {
+                int v = var(rl[k]);
+                if (!seen[v] && levels[v] > 0) {
+                    redundant = false;
+                    break;
+                }
+            }
+        }
+        if (!redundant) {
+            out_learnt[keep++] = out_learnt[i];
+        }
+    }
+    out_learnt.resize(keep);
+    for (int lit : marked) {
+        seen[var(lit)] = 0;
+    }
+
+    if (out_learnt.size() == 1) {
+        out_btlevel = 0;
+    } else {
+        size_t max_i = 1;
+        for (size_t i = 2; i < out_learnt.size(); i++) {
+            if (levels[var(out_learnt[i])] > levels[var(out_learnt[max_i])]) {
+                max_i = i;
+            }
+        }
+        std::swap(out_learnt[1], out_learnt[max_i]);
+        out_btlevel = levels[var(out_learnt[1])];
+    }
+}
+
+void SatSolver::analyzeFinal(int lit, const std::vector<int>& assumptions) {
+    // lit is an assumption that is currently false; collect the assumptions that falsified it
+    conflict_assumptions.clear();
+    conflict_assumptions.push_back(toExternal(lit));
+    if (decisionLevel() == 0) return;
+
+    seen[var(lit)] = 1;
+    for (int i = static_cast<int>(trail.size()) - 1; i >= trail_lim[0]; i--) {
+        int v = var(trail[i]);
+        if (!seen[v]) continue;
+        if (reasons[v] == -1) {
+            conflict_assumptions.push_back(toExternal(trail[i]));
+        } else {
+            const std::vector<int>& c = clauses[reasons[v]].lits;
+            for (size_t j = 1; j < c.size(); j++) {
+                if (levels[var(c[j])] > 0) {
+                    seen[var(c[j])] = 1;
+                }
+            }
+        }
+        seen[v] = 0;
+    }
+    seen[var(lit)] = 0;
+
+    // Keep the core in the order the caller supplied the assumptions
+    std::vector<int> ordered;
+    for (int a : assumptions) {
+        if (std::find(conflict_assumptions.begin(), conflict_assumptions.end(), a) != conflict_assumptions.end() &&
+            std::find(ordered.begin(), ordered.end(), a) == ordered.end()) {
+            ordered.push_back(a);
+        }
+    }
+    conflict_assumptions = ordered;
+}
+
+void SatSolver::cancelUntil(int level) {
+    if (decisionLevel() <= level) return;
+    for (int c = static_cast<int>(trail.size()) - 1; c >= trail_lim[level]; c--) {
+        int v = var(trail[c]);
+        assigns[v] = 0;
+        reasons[v] = -1;
+        polarity[v] = (trail[c] & 1) ? 0 : 1;
+        heapInsert(v);
+    }
+    trail.resize(trail_lim[level]);
+    trail_lim.resize(level);
+    qhead = trail.size();
+}
+
+int SatSolver::pickBranchLit() {
+    while (!heap.empty()) {
+        int v = heapPop();
+        if (assigns[v] == 0) {
+            return polarity[v] ? 2 * v : 2 * v + 1;
+        }
+    }
+    return -1;
+}
+
+bool SatSolver::locked(int cref) const {
+    const std::vector<int>& c = clauses[cref].lits;
+    return reasons[var(c[0])] == cref && litValue(c[0]) == 1;
+}
+
+void SatSolver::reduceLearnts() {
+    std::sort(learnts.begin(), learnts.end(), [this](int a, int b) {
+        return clauses[a].activity < clauses[b].activity;
+    });
+    size_t half = learnts.size() / 2;
+    std::vector<int> kept;
+    for (size_t i = 0; i < learnts.size(); i++) {
+        Clause& clause = clauses[learnts[i]];
+        if (i < half && clause.lits.size() > 2 && !locked(learnts[i])) {
+            clause.deleted = true;
+        } else {
+            kept.push_back(learnts[i]);
+        }
+    }
+    learnts = kept;
+
+    for (auto& ws : watches) {
+        ws.erase(std::remove_if(ws.begin(), ws.end(), [this](const Watcher& w) {
+            return clauses[w.cref].deleted;
+        }), ws.end());
+    }
+    for (auto& clause : clauses) {
+        if (clause.deleted && !clause.lits.empty()) {
+            std::vector<int>().swap(clause.lits);
+        }
+    }
+}
+
+void SatSolver::bumpVar(int v) {
+    activity[v] += var_inc;
+    if (activity[v] > 1e100) {
+        for (auto& a : activity) a *= 1e-100;
+        var_inc *= 1e-100;
+    }
+    if (heap_index[v] >= 0) {
+        heapUp(heap_index[v]);
+    }
+}
+
+void SatSolver::bumpClause(int cref) {
+    clauses[cref].activity += cla_inc;
+    if (clauses[cref].activity > 1e20) {
+        for (int l : learnts) clauses[l].activity *= 1e-20;
+        cla_inc *= 1e-20;
+    }
+}
+
+void SatSolver::heapInsert(int v) {
+    if (heap_index[v] >= 0) return;
+    heap_index[v] = static_cast<int>(heap.size());
+    heap.push_back(v);
+    heapUp(heap.size() - 1);
+}
+
+void SatSolver::heapUp(size_t pos) {
+    int v = heap[pos];
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (activity[heap[parent]] >= activity[v]) break;
+        heap[pos] = heap[parent];
+        heap_index[heap[pos]] = static_cast<int>(pos);
+        pos = parent;
+    }
+    heap[pos] = v;
+    heap_index[v] = static_cast<int>(pos);
+}
+
+void SatSolver::heapDown(size_t pos) {
+    int v = heap[pos];
+    for (;;) {
+        size_t child = 2 * pos + 1;
+        if (child >= heap.size()) break;
+        if (child + 1 < heap.size() && activity[heap[child + 1]] > activity[heap[child]]) {
+            child++;
+        }
+        if (activity[heap[child]] <= activity[v]) break;
+        heap[pos] = heap[child];
+        heap_index[heap[pos]] = static_cast<int>(pos);
+        pos = child;
+    }
+    heap[pos] = v;
+    heap_index[v] = static_cast<int>(pos);
+}
+
+int SatSolver::heapPop() {
+    int top = heap[0];
+    heap_index[top] = -1;
+    int last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        heap[0] = last;
+        heap_index[last] = 0;
+        heapDown(0);
+    }
+    return top;
+}
+
+long long SatSolver::luby(long long index) {
+    long long size = 1, seq = 0;
+    while (size < index + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+    long long value = 1;
+    while (size - 1 != index) {
+        size = (size - 1) >> 1;
+        seq--;
+        index = index % size;
+    }
+    while (seq-- > 0) value *= 2;
+    return value;
+}
+
+SatSolver::Result SatSolver::solve(const std::vector<int>& assumptions) {
+    conflict_assumptions.clear();
+    if (!ok) return Result::Unsatisfiable;
+
+    std::vector<int> internal_assumptions;
+    for (int lit : assumptions) {
+        reserveVars(std::abs(lit));
+        internal_assumptions.push_back(toInternal(lit));
+    }
+    max_learnts = std::max(max_learnts, clauses.size() / 3.0);
+
+    std::vector<int> learnt_clause;
+    long long restarts = 0;
+    for (;;) {
+        long long conflict_limit = luby(restarts++) * 100;
+        long long conflicts = 0;
+
+        for (;;) {
+            int confl = propagate();
+            if (confl != -1) {
+                conflicts++;
+                if (decisionLevel() == 0) {
+                    ok = false;
+                    return Result::Unsatisfiable;
+                }
+                int btlevel = 0;
+                analyze(confl, learnt_clause, btlevel);
+                cancelUntil(btlevel);
+                if (learnt_clause.size() == 1) {
+                    enqueue(learnt_clause[0], -1);
+                } else {
+                    int cref = attachClause(learnt_clause, true);
+                    bumpClause(cref);
+                    enqueue(learnt_clause[0], cref);
+                }
+                var_inc /= 0.95;
+                cla_inc /= 0.999;
+                continue;
+            }
+
+            if (interrupt_flag && interrupt_flag->load(std::memory_order_relaxed)) {
+                cancelUntil(0);
+                return Result::Unknown;
+            }
+            if (conflicts >= conflict_limit) {
+                cancelUntil(0);
+                break;
+            }
+            if (static_cast<double>(learnts.size()) - trail.size() >= max_learnts) {
+                reduceLearnts();
+                max_learnts *= 1.1;
+            }
+
+            int next = -1;
+            while (decisionLevel() < static_cast<int>(internal_assumptions.size())) {
+                int p = internal_assumptions[decisionLevel()];
+                if (litValue(p) == 1) {
+                    trail_lim.push_back(static_cast<int>(trail.size()));
+                } else if (litValue(p) == -1) {
+                    analyzeFinal(p, assumptions);
+                    cancelUntil(0);
+                    return Result::Unsatisfiable;
+                } else {
+                    next = p;
+                    break;
+                }
+            }
+
+            if (next == -1) {
+                next = pickBranchLit();
+                if (next == -1) {
+                    model_values.assign(assigns.begin(), assigns.end());
+                    cancelUntil(0);
+                    return Result::Satisfiable;
+                }
+            }
+            trail_lim.push_back(static_cast<int>(trail.size()));
+            enqueue(next, -1);
+        }
+    }
+}
+
+bool SatSolver::modelValue(int var) const {
+    return var > 0 && static_cast<size_t>(var) < model_values.size() && model_values[var] == 1;
+}
+
+const std::vector<int8_t>& SatSolver::model() const {
+    return model_values;
+}
+
+const std::vector<int>& SatSolver::conflictAssumptions() const {
+    return conflict_assumptions;
+}
+
+} // namespace witness
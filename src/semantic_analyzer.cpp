@@ -1,14 +1,25 @@
 #include "semantic_analyzer.hpp"
 #include "conflict_analyzer.hpp"
+#include "bdd.hpp"
+#include "clause_linter.hpp"
+#include "cnf_encoder.hpp"
+#include "maxsat_solver.hpp"
+#include "model_pager.hpp"
+#include "sat_solver.hpp"
+#include "solver_portfolio.hpp"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
 #include <cstddef>
+#include <cstdio>
 #include <set>
+#include <thread>
 #include <ast.hpp>
 #include <sstream>
+#include <filesystem>
 #include <fstream>
 #include <cstdlib>
+#include <unistd.h>
 
 namespace witness {
 
@@ -41,12 +52,25 @@ SemanticAnalyzer::SemanticAnalyzer() {
     system_operations.insert("litis");
     system_operations.insert("meet");
     system_operations.insert("domain");
+    system_operations.insert("entails");
+    system_operations.insert("party");
     
     // Initialize asset ID tracking for satisfiability checking
     next_asset_id = 1;
     
     // Initialize solver mode
     solverMode = "exhaustive";
+    modelsMode = "all";
+    backboneMode = false;
+    collectBlocksOnly = false;
+    lintRedundant = false;
+    models_page_offset = 0;
+    models_page_count = 0;
+    clauseImpact = false;
+    suggestJoins = false;
+    partiesMode = false;
+    marginalsMode = false;
+    block_counter = 0;
     
     // Initialize verbosity flags
     verbose = false;
@@ -64,6 +88,228 @@ std::string SemanticAnalyzer::getSolverMode() const {
     return solverMode;
 }
 
+void SemanticAnalyzer::setModelsMode(const std::string& mode) {
+    modelsMode = mode;
+}
+
+std::string SemanticAnalyzer::getModelsMode() const {
+    return modelsMode;
+}
+
+void SemanticAnalyzer::setModelsPage(uint64_t offset, size_t count) {
+    models_page_offset = offset;
+    models_page_count = count;
+}
+
+void SemanticAnalyzer::setOptimizeQuery(const std::string& query) {
+    optimizeQuery = query;
+    std::string error;
+    if (!query.empty() && !OptimizeQuery::parse(query, optimize_query, error)) {
+        reportError("Invalid optimization query: " + error);
+        optimizeQuery.clear();
+    }
+}
+
+std::string SemanticAnalyzer::getOptimizeQuery() const {
+    return optimizeQuery;
+}
+
+void SemanticAnalyzer::setConflictBudget(double seconds) {
+    conflict_analyzer->setEnumerationBudget(seconds);
+}
+
+double SemanticAnalyzer::getConflictBudget() const {
+    return conflict_analyzer->getEnumerationBudget();
+}
+
+void SemanticAnalyzer::setEarliestConflict(bool enabled) {
+    conflict_analyzer->setLocalizeEarliest(enabled);
+}
+
+bool SemanticAnalyzer::getEarliestConflict() const {
+    return conflict_analyzer->getLocalizeEarliest();
+}
+
+void SemanticAnalyzer::setBackboneMode(bool enabled) {
+    backboneMode = enabled;
+}
+
+bool SemanticAnalyzer::getBackboneMode() const {
+    return backboneMode;
+}
+
+void SemanticAnalyzer::setMarginalsMode(bool enabled) {
+    marginalsMode = enabled;
+}
+
+bool SemanticAnalyzer::getMarginalsMode() const {
+    return marginalsMode;
+}
+
+void SemanticAnalyzer::setLintRedundant(bool enabled) {
+    lintRedundant = enabled;
+}
+
+bool SemanticAnalyzer::getLintRedundant() const {
+    return lintRedundant;
+}
+
+void SemanticAnalyzer::setClauseImpact(bool enabled) {
+    clauseImpact = enabled;
+}
+
+bool SemanticAnalyzer::getClauseImpact() const {
+    return clauseImpact;
+}
+
+void SemanticAnalyzer::setSuggestJoins(bool enabled) {
+    suggestJoins = enabled;
+}
+
+bool SemanticAnalyzer::getSuggestJoins() const {
+    return suggestJoins;
+}
+
+void SemanticAnalyzer::setPartiesMode(bool enabled) {
+    partiesMode = enabled;
+}
+
+bool SemanticAnalyzer::getPartiesMode() const {
+    return partiesMode;
+}
+
+void SemanticAnalyzer::addActionDictionary(const std::vector<ActionPattern>& patterns) {
+    action_dictionary.addPatterns(patterns);
+}
+
+void SemanticAnalyzer::setAssetLikelihoods(const std::string& spec) {
+    std::string error;
+    asset_likelihoods.clear();
+    if (!spec.empty() && !parseLikelihoods(spec, asset_likelihoods, error)) {
+        reportError("Invalid asset likelihoods: " + error);
+        asset_likelihoods.clear();
+    }
+}
+
+bool SemanticAnalyzer::parseLikelihoods(const std::string& spec, std::unordered_map<std::string, double>& likelihoods,
+                                        std::string& error) {
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string term = spec.substr(start, end - start);
+        size_t at = term.find('@');
+        if (at == std::string::npos || at == 0) {
+            error = "expected NAME@PROBABILITY, got '" + term + "'";
+            return false;
+        }
+        std::string value = term.substr(at + 1);
+        size_t parsed = 0;
+        double probability = -1.0;
+        try {
+            probability = std::stod(value, &parsed);
+        } catch (const std::exception&) {
+            parsed = 0;
+        }
+        if (parsed == 0 || parsed != value.size() || !(probability >= 0.0 && probability <= 1.0)) {
+            error = "probability for '" + term.substr(0, at) + "' must be between 0 and 1, got '" + value + "'";
+            return false;
+        }
+        likelihoods[term.substr(0, at)] = probability;
+        start = end + 1;
+    }
+    return true;
+}
+
+void SemanticAnalyzer::setLitisQueries(const std::vector<std::vector<std::string>>& queries) {
+    litis_queries = queries;
+}
+
+bool SemanticAnalyzer::parseQueries(std::istream& input, std::vector<std::vector<std::string>>& queries,
+                                    std::string& error) {
+    std::string line;
+    int line_number = 0;
+    while (std::getline(input, line)) {
+        line_number++;
+        size_t comment = std::min(line.find('#'), line.find("//"));
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::vector<std::string> targets;
+        std::string name;
+        for (char c : line + " ") {
+            if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+                name += c;
+            } else if (c == ',' || std::isspace(static_cast<unsigned char>(c))) {
+                if (!name.empty()) targets.push_back(name);
+                name.clear();
+            } else {
+                error = "unexpected '" + std::string(1, c) + "' on line " + std::to_string(line_number);
+                return false;
+            }
+        }
+        if (!targets.empty()) queries.push_back(targets);
+    }
+    if (queries.empty()) {
+        error = "no target sets found";
+        return false;
+    }
+    return true;
+}
+
+void SemanticAnalyzer::setAttributeQueries(const std::vector<ConceptLattice::Attributes>& queries) {
+    attribute_queries = queries;
+}
+
+void SemanticAnalyzer::setCollectBlocksOnly(bool enabled) {
+    collectBlocksOnly = enabled;
+}
+
+const std::vector<ClauseBlock>& SemanticAnalyzer::getCollectedBlocks() const {
+    return collected_blocks;
+}
+
+const std::unordered_map<std::string, int>& SemanticAnalyzer::getAssetIDs() const {
+    return asset_to_id;
+}
+
+std::vector<std::string> SemanticAnalyzer::getDeclaredAssets() const {
+    std::vector<std::string> names;
+    for (const auto& pair : symbol_table) {
+        if (pair.second.type_keyword == "asset" && pair.second.asset_components.size() >= 3) {
+            names.push_back(pair.first);
+        }
+    }
+    return names;
+}
+
+std::vector<std::string> SemanticAnalyzer::getAssetComponentsByName(const std::string& asset_name) {
+    TypeInfo* asset_info = lookupType(asset_name);
+    if (asset_info && asset_info->type_keyword == "asset") {
+        std::vector<std::string> components = asset_info->asset_components;
+        if (asset_info->action_label >= 0) components[1] = actionText(*asset_info);
+        return components;
+    }
+    return {};
+}
+
+const std::vector<std::string>& SemanticAnalyzer::getErrors() const {
+    return errors;
+}
+
+void SemanticAnalyzer::collectBlock(const std::string& operation, ClauseView clauses) {
+    // The symbol-table pass runs system operations before any clause is seen
+    if (clauses.empty()) return;
+    
+    // Register every asset so the block's variables are all known to the caller
+    std::set<int> asset_ids;
+    for (const auto& clause : clauses) {
+        collectAssetIDs(clause.expr, asset_ids);
+    }
+    // The block outlives current_clauses, so it keeps its own copy
+    std::vector<ClauseInfo> storage;
+    collected_blocks.push_back({operation + " #" + std::to_string(collected_blocks.size() + 1), clauses.materialize(storage)});
+}
+
 void SemanticAnalyzer::setVerbose(bool v) {
     verbose = v;
 }
@@ -105,6 +351,13 @@ void SemanticAnalyzer::addClause(const std::string& clause_name, const std::vect
     clause.expression = expression;
     clause.expr = expr;
     current_clauses.push_back(clause);
+
+    std::set<int> asset_ids;
+    collectAssetIDs(expr, asset_ids);
+    clause_asset_ids.emplace_back(asset_ids.begin(), asset_ids.end());
+    for (int asset_id : asset_ids) {
+        asset_clause_index[asset_id].push_back(current_clauses.size() - 1);
+    }
     std::string pos_str = "";
     for (int lit : positive_literals) {
         pos_str += "+" + std::to_string(lit) + " ";
@@ -113,83 +366,1196 @@ void SemanticAnalyzer::addClause(const std::string& clause_name, const std::vect
     for (int lit : negative_literals) {
         neg_str += "-" + std::to_string(lit) + " ";
     }
-    reportWarning("Clause '" + clause_name + "' added: [" + pos_str + neg_str + "] from '" + expression + "'");
-    printClauseTruthTable(current_clauses.back());
+    reportWarning("Clause '" + clause_name + "' added: [" + pos_str + neg_str + "] from '" + expression + "'");
+    printClauseTruthTable(current_clauses.back());
+}
+
+void SemanticAnalyzer::clearClauses() {
+    current_clauses.clear();
+    clause_asset_ids.clear();
+    asset_clause_index.clear();
+}
+
+SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateTruthTable() {
+    // Optimization and minimal models use the SAT-based searches whatever the engine
+    if (!optimizeQuery.empty()) {
+        return generateOptimalTruthTable(current_clauses);
+    }
+    if (modelsMode == "minimal") {
+        return generateMinimalModelTruthTable(current_clauses);
+    }
+
+    std::string engine = solverMode;
+    if (engine == "auto") {
+        engine = selectEngine(current_clauses);
+    }
+    
+    if (engine == "external") {
+        generateExternalSolverTruthTable();
+        
+        // Read results from CUDA solver using the most recent result file
+        std::string result_filename = "zdd_" + std::to_string(global_check_counter) + ".bin";
+        std::ifstream result_file(result_filename, std::ios::binary);
+        if (!result_file.is_open()) {
+            SatisfiabilityResult result;
+            result.satisfiable = false;
+            result.error_message = "External solver mode: Could not read CUDA solver results";
+            return result;
+        }
+        
+        SatisfiabilityResult result;
+        result.satisfiable = false;
+        
+        // Read combinations from binary file
+        while (result_file.good()) {
+            int size;
+            result_file.read(reinterpret_cast<char*>(&size), sizeof(int));
+            if (result_file.eof()) break;
+            
+            if (size > 0 && size <= 1000) { // Sanity check
+                std::vector<int> combination(size);
+                result_file.read(reinterpret_cast<char*>(combination.data()), size * sizeof(int));
+                if (result_file.good()) {
+                    result.assignments.push_back(combination);
+                }
+            }
+        }
+        result_file.close();
+        
+        result.satisfiable = !result.assignments.empty();
+        if (result.satisfiable) {
+            result.error_message = "External solver mode: " + std::to_string(result.assignments.size()) + " satisfying assignments found";
+        } else {
+            // Create reverse mapping from asset IDs to asset names
+            std::unordered_map<int, std::string> id_to_asset;
+            for (const auto& pair : asset_to_id) {
+                id_to_asset[pair.second] = pair.first;
+            }
+            
+            // Use conflict analyzer to find minimal conflicting set
+            std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(current_clauses, id_to_asset);
+            std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, current_clauses, id_to_asset);
+            
+            result.error_message = "External solver mode: No satisfying assignments found";
+            result.conflicting_clauses = conflicting_clauses;
+            
+            // Print conflict report
+            std::cout << "\n" << conflict_report << std::endl;
+            reportConflictEnumeration(current_clauses, id_to_asset);
+        }
+        
+        return result;
+    }
+
+    SatisfiabilityResult result;
+    result.satisfiable = false;
+
+    if (current_clauses.empty()) {
+        result.satisfiable = true;
+        result.assignments.push_back({}); // Empty assignment satisfies no clauses
+        return result;
+    }
+
+    if (engine == "exhaustive") {
+        // Use current exhaustive approach
+        return generateExhaustiveTruthTable();
+    } else if (engine == "sat") {
+        return generateSatTruthTable();
+    } else if (engine == "portfolio") {
+        return generatePortfolioTruthTable(current_clauses);
+    } else {
+        reportError("Unknown solver mode: " + solverMode);
+        return result;
+    }
+}
+
+SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSatTruthTable() {
+    SatisfiabilityResult result;
+    result.satisfiable = false;
+
+    if (current_clauses.empty()) {
+        result.satisfiable = true;
+        result.assignments.push_back({}); // Empty assignment satisfies no clauses
+        return result;
+    }
+
+    // Collect all unique asset IDs used in all clause expressions
+    std::set<int> all_asset_ids;
+    for (const auto& clause : current_clauses) {
+        collectAssetIDs(clause.expr, all_asset_ids);
+    }
+    std::vector<int> asset_ids(all_asset_ids.begin(), all_asset_ids.end());
+
+    reportWarning("SAT enumeration: " + std::to_string(asset_ids.size()) + " assets, " +
+                  std::to_string(current_clauses.size()) + " clauses");
+
+    enumerateModels(current_clauses, asset_ids, result.assignments);
+    result.satisfiable = !result.assignments.empty();
+
+    if (result.satisfiable) {
+        reportWarning("SAT enumeration completed: " + std::to_string(result.assignments.size()) + " satisfying assignments found");
+    } else {
+        // Create reverse mapping from asset IDs to asset names
+        std::unordered_map<int, std::string> id_to_asset;
+        for (const auto& pair : asset_to_id) {
+            id_to_asset[pair.second] = pair.first;
+        }
+        
+        // Use conflict analyzer to find minimal conflicting set
+        std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(current_clauses, id_to_asset);
+        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, current_clauses, id_to_asset);
+        
+        result.error_message = "No satisfying assignments found - clauses are unsatisfiable";
+        result.conflicting_clauses = conflicting_clauses;
+        
+        reportError(result.error_message);
+        std::cout << "\n" << conflict_report << std::endl;
+        reportConflictEnumeration(current_clauses, id_to_asset);
+    }
+
+    return result;
+}
+
+void SemanticAnalyzer::reportConflictEnumeration(const std::vector<ClauseInfo>& clauses,
+                                                 const std::unordered_map<int, std::string>& asset_mapping) {
+    double budget = conflict_analyzer->getEnumerationBudget();
+    if (budget <= 0 || quiet) return;
+    
+    ConflictEnumeration enumeration = conflict_analyzer->enumerateConflicts(clauses, asset_mapping, budget);
+    auto describe = [&](const std::vector<size_t>& indices) {
+        std::string names = "{";
+        for (size_t i = 0; i < indices.size(); ++i) {
+            if (i > 0) names += ", ";
+            names += clauses[indices[i]].name;
+        }
+        return names + "}";
+    };
+    
+    std::cout << "\nEnumerating conflicts (budget " << budget << "s):" << std::endl;
+    for (size_t i = 0; i < enumeration.muses.size(); ++i) {
+        std::cout << "  MUS " << i + 1 << ": " << describe(enumeration.muses[i]) << std::endl;
+    }
+    for (size_t i = 0; i < enumeration.mcses.size(); ++i) {
+        std::cout << "  MCS " << i + 1 << ": " << describe(enumeration.mcses[i]) << std::endl;
+    }
+    std::ostringstream elapsed;
+    elapsed.precision(3);
+    elapsed << std::fixed << enumeration.elapsed_seconds;
+    std::cout << (enumeration.complete ? "Conflict enumeration complete: "
+                                       : "Conflict enumeration budget exhausted, partial results: ")
+              << enumeration.muses.size() << " MUS(es), " << enumeration.mcses.size() << " MCS(es) in "
+              << elapsed.str() << "s" << std::endl;
+}
+
+bool SemanticAnalyzer::enumerateModels(ClauseView clauses, const std::vector<int>& asset_ids,
+                                       std::vector<std::vector<int>>& models, const std::atomic<bool>* cancel) {
+    SatSolver solver;
+    solver.setInterruptFlag(cancel);
+    CnfEncoder encoder(solver, asset_to_id);
+    for (const auto& clause : clauses) {
+        encoder.addConstraint(clause.expr);
+    }
+
+    // Enumerate models projected onto asset_ids, blocking each one as it is found
+    models.clear();
+    SatSolver::Result status;
+    while ((status = solver.solve()) == SatSolver::Result::Satisfiable) {
+        std::vector<int> assignment;
+        std::vector<int> blocking;
+        for (int asset_id : asset_ids) {
+            bool value = solver.modelValue(asset_id);
+            assignment.push_back(value ? asset_id : -asset_id);
+            blocking.push_back(value ? -asset_id : asset_id);
+        }
+        models.push_back(assignment);
+        if (blocking.empty() || !solver.addClause(blocking)) {
+            status = SatSolver::Result::Unsatisfiable;
+            break;
+        }
+    }
+    if (status == SatSolver::Result::Unknown) {
+        return false;
+    }
+
+    // Report models in the same order as the exhaustive truth table
+    std::sort(models.begin(), models.end(), [](const std::vector<int>& a, const std::vector<int>& b) {
+        for (size_t i = a.size(); i-- > 0;) {
+            if ((a[i] > 0) != (b[i] > 0)) return b[i] > 0;
+        }
+        return false;
+    });
+    return true;
+}
+
+bool SemanticAnalyzer::enumerateExhaustive(ClauseView clauses, const std::vector<int>& asset_ids,
+                                           std::vector<std::vector<int>>& models, const std::atomic<bool>* cancel) {
+    models.clear();
+    long long num_assignments = 1LL << asset_ids.size();
+    for (long long assignment = 0; assignment < num_assignments; assignment++) {
+        // Poll for cancellation every 1024 assignments
+        if (cancel && (assignment & 1023) == 0 && cancel->load()) {
+            return false;
+        }
+
+        std::vector<int> current_assignment;
+        std::map<int, bool> assignment_map;
+        for (size_t i = 0; i < asset_ids.size(); i++) {
+            bool value = (assignment >> i) & 1;
+            assignment_map[asset_ids[i]] = value;
+            current_assignment.push_back(value ? asset_ids[i] : -asset_ids[i]);
+        }
+
+        bool satisfies_all = true;
+        for (const auto& clause : clauses) {
+            if (!evalExpr(clause.expr, assignment_map)) {
+                satisfies_all = false;
+                break;
+            }
+        }
+        if (satisfies_all) {
+            models.push_back(current_assignment);
+        }
+    }
+    return true;
+}
+
+bool SemanticAnalyzer::enumerateMinimalModels(ClauseView clauses, const std::vector<int>& asset_ids,
+                                              std::vector<std::vector<int>>& models, const std::atomic<bool>* cancel) {
+    SatSolver solver;
+    solver.setInterruptFlag(cancel);
+    solver.setDefaultPolarity(false);
+    CnfEncoder encoder(solver, asset_to_id);
+    for (const auto& clause : clauses) {
+        encoder.addConstraint(clause.expr);
+    }
+
+    models.clear();
+    SatSolver::Result status;
+    while ((status = solver.solve()) == SatSolver::Result::Satisfiable) {
+        std::set<int> true_assets;
+        for (int asset_id : asset_ids) {
+            if (solver.modelValue(asset_id)) true_assets.insert(asset_id);
+        }
+
+        // Shrink: look for a model whose true assets are a strict subset of the current ones
+        while (!true_assets.empty()) {
+            int activation = solver.newVar();
+            std::vector<int> drop_one = {-activation};
+            for (int asset_id : true_assets) {
+                drop_one.push_back(-asset_id);
+            }
+            solver.addClause(drop_one);
+
+            std::vector<int> assumptions = {activation};
+            for (int asset_id : asset_ids) {
+                if (!true_assets.count(asset_id)) assumptions.push_back(-asset_id);
+            }
+            SatSolver::Result shrink = solver.solve(assumptions);
+            solver.addClause({-activation}); // Retire the temporary constraint
+            if (shrink == SatSolver::Result::Unknown) return false;
+            if (shrink == SatSolver::Result::Unsatisfiable) break;
+
+            std::set<int> smaller;
+            for (int asset_id : true_assets) {
+                if (solver.modelValue(asset_id)) smaller.insert(asset_id);
+            }
+            true_assets = smaller;
+        }
+
+        std::vector<int> assignment;
+        std::vector<int> blocking;
+        for (int asset_id : asset_ids) {
+            bool value = true_assets.count(asset_id) > 0;
+            assignment.push_back(value ? asset_id : -asset_id);
+            if (value) blocking.push_back(-asset_id);
+        }
+        models.push_back(assignment);
+
+        // Block this model and every superset of it
+        if (blocking.empty() || !solver.addClause(blocking)) {
+            status = SatSolver::Result::Unsatisfiable;
+            break;
+        }
+    }
+    if (status == SatSolver::Result::Unknown) {
+        return false;
+    }
+
+    // Report models in the same order as the exhaustive truth table
+    std::sort(models.begin(), models.end(), [](const std::vector<int>& a, const std::vector<int>& b) {
+        for (size_t i = a.size(); i-- > 0;) {
+            if ((a[i] > 0) != (b[i] > 0)) return b[i] > 0;
+        }
+        return false;
+    });
+    return true;
+}
+
+bool SemanticAnalyzer::computeBackbone(ClauseView clauses, const std::vector<int>& asset_ids,
+                                       std::vector<int>& backbone, const std::atomic<bool>* cancel) {
+    SatSolver solver;
+    solver.setInterruptFlag(cancel);
+    CnfEncoder encoder(solver, asset_to_id);
+    for (const auto& clause : clauses) {
+        encoder.addConstraint(clause.expr);
+    }
+
+    backbone.clear();
+    if (solver.solve() != SatSolver::Result::Satisfiable) {
+        return false;
+    }
+
+    // Every asset starts as a candidate with its value in the first model
+    std::vector<int> candidates;
+    for (int asset_id : asset_ids) {
+        candidates.push_back(solver.modelValue(asset_id) ? asset_id : -asset_id);
+    }
+
+    std::vector<char> dropped(candidates.size(), 0);
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (dropped[i]) continue;
+        SatSolver::Result status = solver.solve({-candidates[i]});
+        if (status == SatSolver::Result::Unknown) {
+            return false;
+        }
+        if (status == SatSolver::Result::Unsatisfiable) {
+            // Forced: fixing it helps every later check
+            backbone.push_back(candidates[i]);
+            solver.addClause({candidates[i]});
+            continue;
+        }
+        // The new model drops every candidate it flips, not just this one
+        for (size_t j = i; j < candidates.size(); j++) {
+            int lit = candidates[j];
+            if (solver.modelValue(std::abs(lit)) != (lit > 0)) dropped[j] = 1;
+        }
+    }
+    return true;
+}
+
+bool SemanticAnalyzer::reportBackbone(ClauseView clauses) {
+    if (clauses.empty()) return true;
+
+    std::set<int> all_asset_ids;
+    for (const auto& clause : clauses) {
+        collectAssetIDs(clause.expr, all_asset_ids);
+    }
+    std::vector<int> asset_ids(all_asset_ids.begin(), all_asset_ids.end());
+
+    std::vector<int> backbone;
+    if (!computeBackbone(clauses, asset_ids, backbone)) return false;
+
+    std::unordered_map<int, std::string> id_to_asset;
+    for (const auto& pair : asset_to_id) {
+        id_to_asset[pair.second] = pair.first;
+    }
+    std::set<int> forced;
+    std::string forced_true;
+    std::string forced_false;
+    for (int lit : backbone) {
+        forced.insert(std::abs(lit));
+        std::string& list = lit > 0 ? forced_true : forced_false;
+        if (!list.empty()) list += ", ";
+        list += id_to_asset[std::abs(lit)];
+    }
+    std::string free_assets;
+    for (int asset_id : asset_ids) {
+        if (forced.count(asset_id)) continue;
+        if (!free_assets.empty()) free_assets += ", ";
+        free_assets += id_to_asset[asset_id];
+    }
+
+    std::cout << "Backbone: forced true {" << forced_true << "}, forced false {" << forced_false
+              << "}, free {" << free_assets << "}" << std::endl;
+    return true;
+}
+
+bool SemanticAnalyzer::reportsDecideSatisfiability() const {
+    return (backboneMode || marginalsMode) && optimizeQuery.empty() && modelsMode == "all" && models_page_count == 0;
+}
+
+bool SemanticAnalyzer::decideWithoutEnumeration(ClauseView clauses, SatisfiabilityResult& result) {
+    reportWarning("Backbone or marginals requested - deciding satisfiability without enumerating models");
+    bool satisfiable = true;
+    bool decided = false;
+    if (backboneMode) {
+        satisfiable = reportBackbone(clauses);
+        decided = true;
+    }
+    if (marginalsMode && satisfiable) {
+        bool diagram_satisfiable = true;
+        if (reportMarginals(clauses, diagram_satisfiable) && !decided) {
+            satisfiable = diagram_satisfiable;
+            decided = true;
+        }
+    }
+    if (!decided) {
+        // The diagram overflowed; fall back to enumeration without repeating the report
+        return false;
+    }
+    if (!satisfiable) {
+        result = unsatisfiableResult(clauses);
+        return true;
+    }
+    result.satisfiable = true;
+    return true;
+}
+
+SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::unsatisfiableResult(ClauseView clauses) {
+    SatisfiabilityResult result;
+    result.satisfiable = false;
+    
+    std::unordered_map<int, std::string> id_to_asset;
+    for (const auto& pair : asset_to_id) {
+        id_to_asset[pair.second] = pair.first;
+    }
+    // The conflict analyzer takes a clause list; a cone is copied only here
+    std::vector<ClauseInfo> storage;
+    const std::vector<ClauseInfo>& clause_list = clauses.materialize(storage);
+    std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(clause_list, id_to_asset);
+    std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, clause_list, id_to_asset);
+    
+    result.error_message = "No satisfying assignments found - clauses are unsatisfiable";
+    result.conflicting_clauses = conflicting_clauses;
+    
+    reportError(result.error_message);
+    std::cout << "\n" << conflict_report << std::endl;
+    reportConflictEnumeration(clause_list, id_to_asset);
+    return result;
+}
+
+std::vector<int> SemanticAnalyzer::diagramVariables(ClauseView clauses,
+                                                    std::unordered_map<std::string, int>& var_of) {
+    std::vector<int> asset_ids;
+    std::set<int> seen_ids;
+    for (const auto& clause : clauses) {
+        std::set<int> clause_ids;
+        collectAssetIDs(clause.expr, clause_ids);
+        for (int asset_id : clause_ids) {
+            if (seen_ids.insert(asset_id).second) asset_ids.push_back(asset_id);
+        }
+    }
+
+    std::unordered_map<int, std::string> id_to_asset;
+    for (const auto& pair : asset_to_id) {
+        id_to_asset[pair.second] = pair.first;
+    }
+    for (size_t i = 0; i < asset_ids.size(); i++) {
+        var_of[id_to_asset[asset_ids[i]]] = static_cast<int>(i);
+    }
+    return asset_ids;
+}
+
+bool SemanticAnalyzer::reportMarginals(ClauseView clauses, bool& satisfiable) {
+    satisfiable = true;
+    if (clauses.empty()) return true;
+
+    std::unordered_map<std::string, int> var_of;
+    std::vector<int> asset_ids = diagramVariables(clauses, var_of);
+
+    std::unordered_map<int, std::string> id_to_asset;
+    for (const auto& pair : asset_to_id) {
+        id_to_asset[pair.second] = pair.first;
+    }
+    std::vector<double> probability;
+    for (int asset_id : asset_ids) {
+        auto it = asset_likelihoods.find(id_to_asset[asset_id]);
+        probability.push_back(it != asset_likelihoods.end() ? it->second : 0.5);
+    }
+
+    Bdd bdd(static_cast<int>(asset_ids.size()));
+    Bdd::Node block = Bdd::True;
+    for (const auto& clause : clauses) {
+        block = bdd.conjoin(block, bdd.compile(clause.expr, var_of));
+    }
+    if (bdd.overflowed()) {
+        std::cout << "Marginals unavailable: decision diagram exceeded its node limit" << std::endl;
+        return false;
+    }
+    // Every node other than False has a model
+    satisfiable = block != Bdd::False;
+    if (!satisfiable) return true;
+
+    BigCount total = bdd.countModels(block);
+    std::vector<BigCount> counts = bdd.marginalCounts(block);
+    double weighted_total = 0.0;
+    std::vector<double> weighted = bdd.weightedMarginals(block, probability, weighted_total);
+
+    std::cout << "Marginals over " << total.toString() << " models (" << bdd.size() << " diagram nodes):" << std::endl;
+    if (!asset_likelihoods.empty()) {
+        std::cout << "  Likelihood of the block: " << weighted_total << std::endl;
+    }
+    std::vector<size_t> by_id(asset_ids.size());
+    for (size_t i = 0; i < by_id.size(); i++) by_id[i] = i;
+    std::sort(by_id.begin(), by_id.end(), [&](size_t a, size_t b) { return asset_ids[a] < asset_ids[b]; });
+    for (size_t i : by_id) {
+        char share[32];
+        snprintf(share, sizeof(share), "%.1f%%", total.isZero() ? 0.0 : 100.0 * counts[i].toDouble() / total.toDouble());
+        std::cout << "  " << id_to_asset[asset_ids[i]] << ": " << counts[i].toString() << " (" << share << ")";
+        if (!asset_likelihoods.empty() && weighted_total > 0.0) {
+            std::cout << ", likelihood " << weighted[i] / weighted_total;
+        }
+        std::cout << std::endl;
+    }
+    return true;
+}
+
+void SemanticAnalyzer::reportClauseImpact(ClauseView clauses) {
+    if (clauses.empty()) return;
+
+    std::unordered_map<std::string, int> var_of;
+    std::vector<int> asset_ids = diagramVariables(clauses, var_of);
+
+    // Each clause is compiled once; the block without clause i is
+    // prefix[i] AND suffix[i + 1], so n removals cost about 3n conjunctions
+    size_t n = clauses.size();
+    Bdd bdd(static_cast<int>(asset_ids.size()));
+    std::vector<Bdd::Node> compiled;
+    for (const auto& clause : clauses) {
+        compiled.push_back(bdd.compile(clause.expr, var_of));
+    }
+    std::vector<Bdd::Node> prefix(n + 1, Bdd::True);
+    std::vector<Bdd::Node> suffix(n + 1, Bdd::True);
+    for (size_t i = 0; i < n; i++) {
+        prefix[i + 1] = bdd.conjoin(prefix[i], compiled[i]);
+    }
+    for (size_t i = n; i-- > 0;) {
+        suffix[i] = bdd.conjoin(compiled[i], suffix[i + 1]);
+    }
+    std::vector<Bdd::Node> without(n);
+    for (size_t i = 0; i < n; i++) {
+        without[i] = bdd.conjoin(prefix[i], suffix[i + 1]);
+    }
+    if (bdd.overflowed()) {
+        std::cout << "Clause impact unavailable: decision diagram exceeded its node limit" << std::endl;
+        return;
+    }
+
+    // The diagram is complete, so counting only reads it and can run in parallel
+    BigCount total = bdd.countModels(prefix[n]);
+    std::vector<BigCount> counts(n);
+    unsigned num_workers = std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<unsigned>(n)));
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < num_workers; w++) {
+        workers.emplace_back([&, w]() {
+            for (size_t i = w; i < n; i += num_workers) {
+                counts[i] = bdd.countModels(without[i]);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Most constraining clauses first
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return counts[b] < counts[a]; });
+
+    std::cout << "Clause impact over " << total.toString() << " models (" << bdd.size() << " diagram nodes):" << std::endl;
+    for (size_t i : order) {
+        std::cout << "  " << clauses[i].name << ": ";
+        if (counts[i] == total) {
+            std::cout << "no effect" << std::endl;
+            continue;
+        }
+        std::cout << "+" << (counts[i] - total).toString() << " models without it (" << counts[i].toString() << ")";
+        if (total.isZero()) {
+            std::cout << ", block becomes SATISFIABLE";
+        }
+        std::cout << std::endl;
+    }
+}
+
+bool SemanticAnalyzer::projectTargetSets(const std::vector<std::vector<std::string>>& target_sets,
+                                         std::vector<std::vector<size_t>>& cones,
+                                         std::vector<std::vector<int>>& targets,
+                                         std::vector<std::vector<std::vector<int>>>& models) {
+    // Cones and targets are resolved up front; the workers only read them
+    cones.clear();
+    targets.clear();
+    for (const auto& query : target_sets) {
+        cones.push_back(relevantClauseIndices(query));
+        std::set<int> cone_ids;
+        for (size_t i : cones.back()) {
+            cone_ids.insert(clause_asset_ids[i].begin(), clause_asset_ids[i].end());
+        }
+        std::set<int> target_ids;
+        for (const auto& asset_name : query) {
+            auto it = asset_to_id.find(asset_name);
+            if (it != asset_to_id.end() && cone_ids.count(it->second)) target_ids.insert(it->second);
+        }
+        targets.emplace_back(target_ids.begin(), target_ids.end());
+    }
+
+    SatSolver solver;
+    CnfEncoder encoder(solver, asset_to_id);
+    std::vector<int> selectors;
+    for (const auto& clause : current_clauses) {
+        int selector = solver.newVar();
+        encoder.addConstraint(clause.expr, selector);
+        selectors.push_back(selector);
+    }
+    bool satisfiable = solver.solve(selectors) == SatSolver::Result::Satisfiable;
+
+    // Each worker enumerates on its own copy; blocking clauses are guarded by a
+    // per-query literal, so they are switched off again for the next query
+    models.assign(target_sets.size(), {});
+    std::atomic<size_t> next(0);
+    unsigned num_workers = std::max(1u, std::min(std::thread::hardware_concurrency(),
+                                                 static_cast<unsigned>(target_sets.size())));
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < num_workers; w++) {
+        workers.emplace_back([&]() {
+            SatSolver local = solver;
+            for (size_t q = next++; q < target_sets.size(); q = next++) {
+                if (cones[q].empty()) {
+                    models[q].push_back({});
+                    continue;
+                }
+                int active = local.newVar();
+                std::vector<int> assumptions = {active};
+                for (size_t i : cones[q]) assumptions.push_back(selectors[i]);
+                while (local.solve(assumptions) == SatSolver::Result::Satisfiable) {
+                    std::vector<int> assignment;
+                    std::vector<int> blocking = {-active};
+                    for (int asset_id : targets[q]) {
+                        bool value = local.modelValue(asset_id);
+                        assignment.push_back(value ? asset_id : -asset_id);
+                        blocking.push_back(value ? -asset_id : asset_id);
+                    }
+                    models[q].push_back(assignment);
+                    if (targets[q].empty()) break;
+                    local.addClause(blocking);
+                }
+                local.addClause({-active});
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return satisfiable;
+}
+
+void SemanticAnalyzer::reportLitisQueries() {
+    if (litis_queries.empty() || current_clauses.empty()) return;
+
+    std::vector<std::vector<size_t>> cones;
+    std::vector<std::vector<int>> targets;
+    std::vector<std::vector<std::vector<int>>> models;
+    projectTargetSets(litis_queries, cones, targets, models);
+
+    std::unordered_map<int, std::string> id_to_asset;
+    for (const auto& pair : asset_to_id) {
+        id_to_asset[pair.second] = pair.first;
+    }
+    std::cout << "Litis queries (" << litis_queries.size() << " against " << current_clauses.size() << " clauses):" << std::endl;
+    for (size_t q = 0; q < litis_queries.size(); q++) {
+        std::cout << "  Query " << (q + 1) << " litis(";
+        for (size_t k = 0; k < litis_queries[q].size(); k++) {
+            std::cout << (k > 0 ? ", " : "") << litis_queries[q][k];
+        }
+        std::cout << "): ";
+        if (models[q].empty()) {
+            std::cout << "UNSATISFIABLE (" << cones[q].size() << " clauses in cone)" << std::endl;
+            continue;
+        }
+        std::sort(models[q].begin(), models[q].end());
+        std::cout << "SATISFIABLE, " << models[q].size() << " projected models over " << cones[q].size() << " clauses";
+        for (size_t m = 0; m < models[q].size(); m++) {
+            std::cout << (m > 0 ? ", " : ": ") << "[";
+            for (size_t k = 0; k < models[q][m].size(); k++) {
+                int lit = models[q][m][k];
+                std::cout << (k > 0 ? ", " : "") << (lit > 0 ? "+" : "-") << id_to_asset[std::abs(lit)];
+            }
+            std::cout << "]";
+        }
+        std::cout << std::endl;
+    }
+}
+
+std::vector<std::string> SemanticAnalyzer::partyAssets(const std::string& subject) {
+    std::vector<std::pair<int, std::string>> assets;
+    for (const auto& pair : asset_to_id) {
+        if (!asset_clause_index.count(pair.second)) continue;
+        TypeInfo* asset_info = lookupType(pair.first);
+        if (!asset_info || asset_info->asset_components.size() < 3) continue;
+        const auto& components = asset_info->asset_components;
+        if (components[0] == subject || components[2] == subject) {
+            assets.push_back({pair.second, pair.first});
+        }
+    }
+    std::sort(assets.begin(), assets.end());
+    std::vector<std::string> names;
+    for (const auto& asset : assets) names.push_back(asset.second);
+    return names;
+}
+
+std::string SemanticAnalyzer::describePartyProjection(const std::string& subject, size_t cone_size,
+                                                      const std::vector<int>& targets,
+                                                      std::vector<std::vector<int>>& models, bool satisfiable) {
+    std::string text = "Party '" + subject + "'";
+    if (targets.empty()) {
+        return text + ": no assets in the current block\n";
+    }
+    if (!satisfiable || models.empty()) {
+        return text + ": UNSATISFIABLE, the current block has no models\n";
+    }
+
+    std::unordered_map<int, std::string> id_to_asset;
+    for (const auto& pair : asset_to_id) {
+        id_to_asset[pair.second] = pair.first;
+    }
+    std::sort(models.begin(), models.end());
+    text += " (" + std::to_string(targets.size()) + " assets, " + std::to_string(cone_size) + " clauses in cone): " +
+            std::to_string(models.size()) + " configuration" + (models.size() == 1 ? "" : "s") + "\n";
+    for (size_t m = 0; m < models.size(); m++) {
+        // The party owes the assets it is the subject of and is owed the others
+        std::string obligations;
+        std::string claims;
+        for (int lit : models[m]) {
+            const std::string& asset_name = id_to_asset[std::abs(lit)];
+            std::string& list = lookupType(asset_name)->asset_components[0] == subject ? obligations : claims;
+            list += (list.empty() ? "" : ", ") + std::string(lit > 0 ? "+" : "-") + asset_name;
+        }
+        text += "  Configuration " + std::to_string(m + 1) + ": obligations [" + obligations + "], claims [" +
+                claims + "]\n";
+    }
+    return text;
+}
+
+void SemanticAnalyzer::reportPartyProjections() {
+    if (!partiesMode || current_clauses.empty()) return;
+
+    // Every subject or authority with an asset in the block, by name
+    std::vector<std::string> subjects;
+    std::vector<std::vector<std::string>> target_sets;
+    std::map<std::string, TypeInfo*> parties;
+    for (auto& pair : symbol_table) {
+        if (pair.second.type_keyword == "subject" || pair.second.type_keyword == "authority") {
+            parties[pair.first] = &pair.second;
+        }
+    }
+    for (const auto& party : parties) {
+        auto assets = partyAssets(party.first);
+        if (assets.empty()) continue;
+        subjects.push_back(party.first);
+        target_sets.push_back(assets);
+    }
+    if (subjects.empty()) return;
+
+    std::vector<std::vector<size_t>> cones;
+    std::vector<std::vector<int>> targets;
+    std::vector<std::vector<std::vector<int>>> models;
+    bool satisfiable = projectTargetSets(target_sets, cones, targets, models);
+
+    std::cout << "Party projections (" << subjects.size() << " parties against " << current_clauses.size()
+              << " clauses):" << std::endl;
+    for (size_t q = 0; q < subjects.size(); q++) {
+        std::cout << describePartyProjection(subjects[q], cones[q].size(), targets[q], models[q], satisfiable);
+    }
+}
+
+bool SemanticAnalyzer::generatePagedTruthTable(ClauseView clauses, const std::vector<int>& projection,
+                                               SatisfiabilityResult& result) {
+    ModelPager pager(clauses, asset_to_id, projection);
+    if (!pager.available() || pager.size().isZero()) return false;
+
+    result.satisfiable = true;
+    result.assignments = pager.page(BigCount(models_page_offset), models_page_count);
+
+    std::string total = pager.size().toString();
+    if (result.assignments.empty()) {
+        std::cout << "Models page starts past the last of " << total << " models" << std::endl;
+        return true;
+    }
+    std::cout << "Models " << models_page_offset + 1 << "-" << models_page_offset + result.assignments.size()
+              << " of " << total << ":" << std::endl;
+    for (size_t i = 0; i < result.assignments.size(); i++) {
+        std::cout << "  Model " << models_page_offset + i + 1 << ": [";
+        for (size_t j = 0; j < result.assignments[i].size(); j++) {
+            int lit = result.assignments[i][j];
+            std::cout << (j > 0 ? ", " : "") << (lit > 0 ? "+" : "") << lit;
+        }
+        std::cout << "]" << std::endl;
+    }
+    return true;
+}
+
+void SemanticAnalyzer::reportClauseLint(ClauseView clauses) {
+    if (clauses.empty()) return;
+
+    // Assign asset IDs up front; the linter's worker threads only read them
+    std::set<int> asset_ids;
+    for (const auto& clause : clauses) {
+        collectAssetIDs(clause.expr, asset_ids);
+    }
+
+    ClauseLinter linter(asset_to_id);
+    std::cout << ClauseLinter::format(linter.lint(clauses), clauses);
+}
+
+SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateMinimalModelTruthTable(ClauseView clauses) {
+    SatisfiabilityResult result;
+    result.satisfiable = false;
+
+    if (clauses.empty()) {
+        result.satisfiable = true;
+        result.assignments.push_back({}); // Empty assignment satisfies no clauses
+        return result;
+    }
+
+    std::set<int> all_asset_ids;
+    for (const auto& clause : clauses) {
+        collectAssetIDs(clause.expr, all_asset_ids);
+    }
+    std::vector<int> asset_ids(all_asset_ids.begin(), all_asset_ids.end());
+
+    reportWarning("Minimal model enumeration: " + std::to_string(asset_ids.size()) + " assets, " +
+                  std::to_string(clauses.size()) + " clauses");
+
+    enumerateMinimalModels(clauses, asset_ids, result.assignments);
+    result.satisfiable = !result.assignments.empty();
+
+    if (result.satisfiable) {
+        // Create reverse mapping from asset IDs to asset names
+        std::unordered_map<int, std::string> id_to_asset;
+        for (const auto& pair : asset_to_id) {
+            id_to_asset[pair.second] = pair.first;
+        }
+
+        reportWarning("Minimal model enumeration completed: " + std::to_string(result.assignments.size()) + " subset-minimal models found");
+        for (size_t i = 0; i < result.assignments.size(); i++) {
+            std::string binding = "Minimal model " + std::to_string(i + 1) + " binds: {";
+            bool first = true;
+            for (int lit : result.assignments[i]) {
+                if (lit < 0) continue;
+                if (!first) binding += ", ";
+                binding += id_to_asset[lit];
+                first = false;
+            }
+            binding += "}";
+            reportWarning(binding);
+        }
+    } else {
+        // Create reverse mapping from asset IDs to asset names
+        std::unordered_map<int, std::string> id_to_asset;
+        for (const auto& pair : asset_to_id) {
+            id_to_asset[pair.second] = pair.first;
+        }
+        
+        // The conflict analyzer takes a clause list; a cone is copied only here
+        std::vector<ClauseInfo> storage;
+        const std::vector<ClauseInfo>& clause_list = clauses.materialize(storage);
+        
+        // Use conflict analyzer to find minimal conflicting set
+        std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(clause_list, id_to_asset);
+        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, clause_list, id_to_asset);
+        
+        result.error_message = "No satisfying assignments found - clauses are unsatisfiable";
+        result.conflicting_clauses = conflicting_clauses;
+        
+        reportError(result.error_message);
+        std::cout << "\n" << conflict_report << std::endl;
+        reportConflictEnumeration(clause_list, id_to_asset);
+    }
+
+    return result;
+}
+
+SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateOptimalTruthTable(ClauseView clauses) {
+    SatisfiabilityResult result;
+    result.satisfiable = false;
+
+    if (clauses.empty()) {
+        result.satisfiable = true;
+        result.assignments.push_back({}); // Empty assignment satisfies no clauses
+        return result;
+    }
+
+    std::set<int> all_asset_ids;
+    for (const auto& clause : clauses) {
+        collectAssetIDs(clause.expr, all_asset_ids);
+    }
+    std::vector<int> asset_ids(all_asset_ids.begin(), all_asset_ids.end());
+
+    // Create reverse mapping from asset IDs to asset names
+    std::unordered_map<int, std::string> id_to_asset;
+    for (const auto& pair : asset_to_id) {
+        id_to_asset[pair.second] = pair.first;
+    }
+
+    // Clauses are hard; each weighted asset is a soft preference for its cheaper value
+    SatSolver solver;
+    CnfEncoder encoder(solver, asset_to_id);
+    for (const auto& clause : clauses) {
+        encoder.addConstraint(clause.expr);
+    }
+    MaxSatSolver maxsat(solver);
+    std::map<int, long long> asset_weights;
+    for (int asset_id : asset_ids) {
+        std::vector<std::string> components = getAssetComponentsByName(id_to_asset[asset_id]);
+        long long weight = optimize_query.weightOf(id_to_asset[asset_id], components);
+        if (weight > 0) {
+            asset_weights[asset_id] = weight;
+            maxsat.addSoft(optimize_query.maximize ? asset_id : -asset_id, weight);
+        }
+    }
+
+    reportWarning("Optimization (" + optimize_query.describe() + "): " + std::to_string(asset_ids.size()) + " assets, " +
+                  std::to_string(asset_weights.size()) + " weighted, " + std::to_string(clauses.size()) + " clauses");
+
+    MaxSatSolver::Result optimum = maxsat.solve();
+    result.satisfiable = optimum.feasible;
+
+    if (result.satisfiable) {
+        std::vector<int> assignment;
+        long long objective = 0;
+        for (int asset_id : asset_ids) {
+            bool value = solver.modelValue(asset_id);
+            assignment.push_back(value ? asset_id : -asset_id);
+            if (value && asset_weights.count(asset_id)) objective += asset_weights[asset_id];
+        }
+        result.assignments.push_back(assignment);
+
+        reportWarning("Optimization completed after " + std::to_string(maxsat.numCores()) + " cores: optimum " +
+                      std::to_string(objective));
+        std::cout << "Optimum (" << optimize_query.describe() << "): " << objective << std::endl;
+    } else {
+        // The conflict analyzer takes a clause list; a cone is copied only here
+        std::vector<ClauseInfo> storage;
+        const std::vector<ClauseInfo>& clause_list = clauses.materialize(storage);
+        
+        // Use conflict analyzer to find minimal conflicting set
+        std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(clause_list, id_to_asset);
+        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, clause_list, id_to_asset);
+        
+        result.error_message = "No satisfying assignments found - clauses are unsatisfiable";
+        result.conflicting_clauses = conflicting_clauses;
+        
+        reportError(result.error_message);
+        std::cout << "\n" << conflict_report << std::endl;
+        reportConflictEnumeration(clause_list, id_to_asset);
+    }
+
+    return result;
+}
+
+SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generatePortfolioTruthTable(ClauseView clauses) {
+    SatisfiabilityResult result;
+    result.satisfiable = false;
+
+    if (clauses.empty()) {
+        result.satisfiable = true;
+        result.assignments.push_back({}); // Empty assignment satisfies no clauses
+        return result;
+    }
+
+    // Asset IDs are assigned here, before any engine thread starts reading asset_to_id
+    std::set<int> all_asset_ids;
+    for (const auto& clause : clauses) {
+        collectAssetIDs(clause.expr, all_asset_ids);
+    }
+    std::vector<int> asset_ids(all_asset_ids.begin(), all_asset_ids.end());
+    block_counter++;
+
+    SolverPortfolio portfolio;
+    // Exhaustive enumeration indexes assignments with 64-bit shifts
+    if (asset_ids.size() < 63) {
+        portfolio.addEngine("exhaustive", [&](const std::atomic<bool>& cancel, std::vector<std::vector<int>>& models) {
+            return enumerateExhaustive(clauses, asset_ids, models, &cancel);
+        });
+    }
+    portfolio.addEngine("sat", [&](const std::atomic<bool>& cancel, std::vector<std::vector<int>>& models) {
+        return enumerateModels(clauses, asset_ids, models, &cancel);
+    });
+
+    // The external input is exported up front so its thread only runs the solver process
+    std::string json_filename;
+    std::string result_filename;
+    bool exported = false;
+    // Its combinations are normalized with 64-bit masks, like exhaustive enumeration
+    if (asset_ids.size() < 63 && access("./tree_fold_cuda", X_OK) == 0) {
+        exported = exportExternalSolverInput(clauses, json_filename, result_filename, true);
+        if (exported) {
+            portfolio.addEngine("external", [&](const std::atomic<bool>& cancel, std::vector<std::vector<int>>& models) {
+                int exit_code = SolverPortfolio::runCancellable({"./tree_fold_cuda", json_filename, result_filename}, cancel);
+                if (exit_code != 0 || !readExternalSolverResults(result_filename, models)) return false;
+                normalizeExternalModels(asset_ids, models);
+                return true;
+            });
+        }
+    }
+
+    if (verbose) {
+        std::cout << "\n=== PORTFOLIO SOLVER: block " << block_counter << " ===" << std::endl;
+        std::cout << "Racing " << asset_ids.size() << " assets, " << clauses.size() << " clauses" << std::endl;
+    }
+
+    PortfolioOutcome outcome = portfolio.race();
+    if (exported) {
+        std::remove(json_filename.c_str());
+        std::remove(result_filename.c_str());
+    }
+
+    if (verbose) {
+        for (const auto& engine : outcome.failed) {
+            std::cout << "  " << engine << ": failed" << std::endl;
+        }
+        for (const auto& engine : outcome.cancelled) {
+            std::cout << "  " << engine << ": cancelled" << std::endl;
+        }
+        if (!outcome.winner.empty()) {
+            std::cout << "Winner: " << outcome.winner << " (" << outcome.elapsed_ms << " ms)" << std::endl;
+        }
+    }
+
+    if (outcome.winner.empty()) {
+        result.error_message = "Portfolio solver: no engine produced an answer";
+        reportError(result.error_message);
+        return result;
+    }
+    reportWarning("Portfolio solver: '" + outcome.winner + "' answered first for block " + std::to_string(block_counter));
+
+    result.assignments = std::move(outcome.assignments);
+    result.satisfiable = !result.assignments.empty();
+
+    if (result.satisfiable) {
+        reportWarning("Portfolio solver completed: " + std::to_string(result.assignments.size()) + " satisfying assignments found");
+    } else {
+        // Create reverse mapping from asset IDs to asset names
+        std::unordered_map<int, std::string> id_to_asset;
+        for (const auto& pair : asset_to_id) {
+            id_to_asset[pair.second] = pair.first;
+        }
+        
+        // The conflict analyzer takes a clause list; a cone is copied only here
+        std::vector<ClauseInfo> storage;
+        const std::vector<ClauseInfo>& clause_list = clauses.materialize(storage);
+        
+        // Use conflict analyzer to find minimal conflicting set
+        std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(clause_list, id_to_asset);
+        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, clause_list, id_to_asset);
+        
+        result.error_message = "No satisfying assignments found - clauses are unsatisfiable";
+        result.conflicting_clauses = conflicting_clauses;
+        
+        reportError(result.error_message);
+        std::cout << "\n" << conflict_report << std::endl;
+        reportConflictEnumeration(clause_list, id_to_asset);
+    }
+
+    return result;
+}
+
+std::vector<ClauseTable> SemanticAnalyzer::buildClauseTables(ClauseView clauses) {
+    std::vector<ClauseTable> tables;
+    for (const auto& clause : clauses) {
+        std::set<int> clause_assets;
+        collectAssetIDs(clause.expr, clause_assets);
+
+        ClauseTable table;
+        table.asset_ids.assign(clause_assets.begin(), clause_assets.end());
+        if (table.asset_ids.size() > static_cast<size_t>(EngineSelector::kMaxTableArity)) {
+            table.complete = false;
+            tables.push_back(table);
+            continue;
+        }
+
+        std::map<int, bool> assignment_map;
+        for (uint32_t assignment = 0; assignment < (uint32_t(1) << table.asset_ids.size()); assignment++) {
+            for (size_t i = 0; i < table.asset_ids.size(); i++) {
+                assignment_map[table.asset_ids[i]] = (assignment >> i) & 1;
+            }
+            if (evalExpr(clause.expr, assignment_map)) {
+                table.models.push_back(assignment);
+            }
+        }
+        tables.push_back(table);
+    }
+    return tables;
 }
 
-SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateTruthTable() {
-    if (solverMode == "external") {
-        generateExternalSolverTruthTable();
-        
-        // Read results from CUDA solver using the most recent result file
-        std::string result_filename = "zdd_" + std::to_string(global_check_counter) + ".bin";
-        std::ifstream result_file(result_filename, std::ios::binary);
-        if (!result_file.is_open()) {
-            SatisfiabilityResult result;
-            result.satisfiable = false;
-            result.error_message = "External solver mode: Could not read CUDA solver results";
-            return result;
-        }
-        
-        SatisfiabilityResult result;
-        result.satisfiable = false;
-        
-        // Read combinations from binary file
-        while (result_file.good()) {
-            int size;
-            result_file.read(reinterpret_cast<char*>(&size), sizeof(int));
-            if (result_file.eof()) break;
-            
-            if (size > 0 && size <= 1000) { // Sanity check
-                std::vector<int> combination(size);
-                result_file.read(reinterpret_cast<char*>(combination.data()), size * sizeof(int));
-                if (result_file.good()) {
-                    result.assignments.push_back(combination);
-                }
+std::string SemanticAnalyzer::selectEngine(ClauseView clauses) {
+    if (clauses.empty()) {
+        return "exhaustive"; // Every engine answers an empty block trivially
+    }
+    
+    block_counter++;
+    bool external_available = access("./tree_fold_cuda", X_OK) == 0;
+
+    BlockProfile profile = engine_selector.profile(buildClauseTables(clauses));
+    EngineEstimate choice = engine_selector.select(profile, external_available);
+
+    if (verbose) {
+        std::cout << "\n=== AUTO SOLVER: block " << block_counter << " ===" << std::endl;
+        std::cout << "Profile: " << EngineSelector::describe(profile) << std::endl;
+        for (const auto& estimate : engine_selector.estimate(profile, external_available)) {
+            std::cout << "  " << estimate.engine << ": ";
+            if (estimate.available) {
+                std::cout << "predicted cost " << estimate.cost;
+            } else {
+                std::cout << "unavailable";
             }
+            std::cout << std::endl;
         }
-        result_file.close();
-        
-        result.satisfiable = !result.assignments.empty();
-        if (result.satisfiable) {
-            result.error_message = "External solver mode: " + std::to_string(result.assignments.size()) + " satisfying assignments found";
-        } else {
-            // Create reverse mapping from asset IDs to asset names
-            std::unordered_map<int, std::string> id_to_asset;
-            for (const auto& pair : asset_to_id) {
-                id_to_asset[pair.second] = pair.first;
+        std::cout << "Selected engine: " << choice.engine << " (predicted cost " << choice.cost << ")" << std::endl;
+    }
+    reportWarning("Auto solver selected '" + choice.engine + "' for block " + std::to_string(block_counter));
+
+    return choice.engine;
+}
+
+std::vector<size_t> SemanticAnalyzer::relevantClauseIndices(const std::vector<std::string>& target_assets) {
+    // Cone of influence: clauses reachable from the targets through shared
+    // assets, since a constraint two hops away can still fix a target
+    std::vector<size_t> cone;
+    std::set<int> reached;
+    std::vector<int> frontier;
+    for (const auto& asset_name : target_assets) {
+        auto it = asset_to_id.find(asset_name);
+        if (it != asset_to_id.end() && reached.insert(it->second).second) {
+            frontier.push_back(it->second);
+        }
+    }
+
+    std::set<size_t> in_cone;
+    while (!frontier.empty()) {
+        int asset_id = frontier.back();
+        frontier.pop_back();
+        auto occurrences = asset_clause_index.find(asset_id);
+        if (occurrences == asset_clause_index.end()) continue;
+        for (size_t i : occurrences->second) {
+            if (!in_cone.insert(i).second) continue;
+            cone.push_back(i);
+            for (int next_id : clause_asset_ids[i]) {
+                if (reached.insert(next_id).second) frontier.push_back(next_id);
             }
-            
-            // Use conflict analyzer to find minimal conflicting set
-            std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(current_clauses, id_to_asset);
-            std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, id_to_asset);
-            
-            result.error_message = "External solver mode: No satisfying assignments found";
-            result.conflicting_clauses = conflicting_clauses;
-            
-            // Print conflict report
-            std::cout << "\n" << conflict_report << std::endl;
         }
-        
-        return result;
     }
 
-    SatisfiabilityResult result;
-    result.satisfiable = false;
+    // Keep source order
+    std::sort(cone.begin(), cone.end());
+    return cone;
+}
 
-    if (current_clauses.empty()) {
-        result.satisfiable = true;
-        result.assignments.push_back({}); // Empty assignment satisfies no clauses
-        return result;
+std::vector<int> SemanticAnalyzer::projectionAssetIDs(ClauseView relevant_clauses,
+                                                      const std::vector<std::string>& target_assets) {
+    std::set<int> cone_ids;
+    for (const auto& clause : relevant_clauses) {
+        collectAssetIDs(clause.expr, cone_ids);
     }
-
-    if (solverMode == "exhaustive") {
-        // Use current exhaustive approach
-        return generateExhaustiveTruthTable();
-    } else {
-        reportError("Unknown solver mode: " + solverMode);
-        return result;
+    std::set<int> target_ids;
+    for (const auto& asset_name : target_assets) {
+        auto it = asset_to_id.find(asset_name);
+        if (it != asset_to_id.end() && cone_ids.count(it->second)) {
+            target_ids.insert(it->second);
+        }
     }
+    reportWarning("Cone of influence: " + std::to_string(relevant_clauses.size()) + " clauses, " +
+                  std::to_string(cone_ids.size() - target_ids.size()) + " non-target assets existentially quantified");
+    return std::vector<int>(target_ids.begin(), target_ids.end());
 }
 
 SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateExhaustiveTruthTable() {
@@ -264,19 +1630,22 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateExhaustiveTruth
         
         // Use conflict analyzer to find minimal conflicting set
         std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(current_clauses, id_to_asset);
-        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, id_to_asset);
+        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, current_clauses, id_to_asset);
         
         result.error_message = "No satisfying assignments found - clauses are unsatisfiable";
         result.conflicting_clauses = conflicting_clauses;
         
         reportError(result.error_message);
         std::cout << "\n" << conflict_report << std::endl;
+        reportConflictEnumeration(current_clauses, id_to_asset);
     }
 
     return result;
 }
 
-SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveTruthTable(const std::vector<std::string>& target_assets) {
+SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveTruthTable(const std::vector<std::string>& target_assets,
+                                                                                     ClauseView relevant_clauses,
+                                                                                     const std::string& engine_label) {
     SatisfiabilityResult result;
     result.satisfiable = false;
 
@@ -286,102 +1655,31 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveTruthT
         return result;
     }
 
-    // Get asset IDs for target assets
-    std::set<int> target_asset_ids;
     for (const auto& asset_name : target_assets) {
-        auto it = asset_to_id.find(asset_name);
-        if (it != asset_to_id.end()) {
-            target_asset_ids.insert(it->second);
-        } else {
+        if (asset_to_id.find(asset_name) == asset_to_id.end()) {
             reportWarning("Asset '" + asset_name + "' not found in current clauses - skipping");
         }
     }
 
-    if (target_asset_ids.empty()) {
-        result.satisfiable = true;
-        result.assignments.push_back({}); // No target assets means trivially satisfiable
-        return result;
-    }
-
-    // Filter clauses to only those that involve target assets
-    std::vector<ClauseInfo> relevant_clauses;
-    for (const auto& clause : current_clauses) {
-        std::set<int> clause_assets;
-        collectAssetIDs(clause.expr, clause_assets);
-        
-        // Check if this clause involves any target assets
-        bool is_relevant = false;
-        for (int target_id : target_asset_ids) {
-            if (clause_assets.find(target_id) != clause_assets.end()) {
-                is_relevant = true;
-                break;
-            }
-        }
-        
-        if (is_relevant) {
-            relevant_clauses.push_back(clause);
-        }
-    }
-
+    // An empty cone also covers targets that no clause mentions
     if (relevant_clauses.empty()) {
         result.satisfiable = true;
         result.assignments.push_back({}); // No relevant clauses means trivially satisfiable
         return result;
     }
 
-    // Collect all unique asset IDs used in relevant clause expressions
-    std::set<int> all_asset_ids;
-    for (const auto& clause : relevant_clauses) {
-        collectAssetIDs(clause.expr, all_asset_ids);
-    }
-    std::vector<int> asset_ids(all_asset_ids.begin(), all_asset_ids.end());
-    int num_assets = asset_ids.size();
-
-    reportWarning("Selective truth table generation: " + std::to_string(num_assets) + " assets, " +
-                  std::to_string(relevant_clauses.size()) + " relevant clauses, " +
-                  std::to_string(1 << num_assets) + " combinations to check");
-
-    // Generate all possible 2^n truth assignments
-    for (int assignment = 0; assignment < (1 << num_assets); assignment++) {
-        std::vector<int> current_assignment;
-        std::map<int, bool> assignment_map;
-        // Create signed literal assignment
-        for (int i = 0; i < num_assets; i++) {
-            int asset_id = asset_ids[i];
-            bool value = (assignment & (1 << i));
-            assignment_map[asset_id] = value;
-            if (value) {
-                current_assignment.push_back(asset_id);  // Positive literal
-            } else {
-                current_assignment.push_back(-asset_id); // Negative literal
-            }
-        }
-
-        // Check if this assignment satisfies all relevant clauses
-        bool satisfies_all = true;
-        for (const auto& clause : relevant_clauses) {
-            bool clause_satisfied = false;
-            try {
-                clause_satisfied = evalExpr(clause.expr, assignment_map);
-            } catch (const std::exception& e) {
-                reportError(std::string("[generateSelectiveTruthTable] Evaluation error: ") + e.what());
-                clause_satisfied = false;
-            }
-            if (!clause_satisfied) {
-                satisfies_all = false;
-                break;
-            }
-        }
+    // Enumerate projected onto the targets: the rest of the cone is existentially
+    // quantified, and blocking on target literals only keeps projections unique
+    std::vector<int> asset_ids = projectionAssetIDs(relevant_clauses, target_assets);
 
-        if (satisfies_all) {
-            result.assignments.push_back(current_assignment);
-        }
-    }
+    reportWarning(engine_label + ": " + std::to_string(asset_ids.size()) + " target assets, " +
+                  std::to_string(relevant_clauses.size()) + " relevant clauses");
 
+    enumerateModels(relevant_clauses, asset_ids, result.assignments);
     result.satisfiable = !result.assignments.empty();
 
     if (result.satisfiable) {
-        reportWarning("Selective truth table generation completed: " + std::to_string(result.assignments.size()) + " satisfying assignments found");
+        reportWarning(engine_label + " completed: " + std::to_string(result.assignments.size()) + " satisfying assignments found");
     } else {
         // Create reverse mapping from asset IDs to asset names
         std::unordered_map<int, std::string> id_to_asset;
@@ -389,21 +1687,27 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveTruthT
             id_to_asset[pair.second] = pair.first;
         }
         
+        // The conflict analyzer takes a clause list; a cone is copied only here
+        std::vector<ClauseInfo> storage;
+        const std::vector<ClauseInfo>& clause_list = relevant_clauses.materialize(storage);
+        
         // Use conflict analyzer to find minimal conflicting set
-        std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(relevant_clauses, id_to_asset);
-        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, id_to_asset);
+        std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(clause_list, id_to_asset);
+        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, clause_list, id_to_asset);
         
         result.error_message = "No satisfying assignments found for selected assets - clauses are unsatisfiable";
         result.conflicting_clauses = conflicting_clauses;
         
         reportError(result.error_message);
         std::cout << "\n" << conflict_report << std::endl;
+        reportConflictEnumeration(clause_list, id_to_asset);
     }
 
     return result;
 }
 
-SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveExternalTruthTable(const std::vector<std::string>& target_assets) {
+SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveExternalTruthTable(const std::vector<std::string>& target_assets,
+                                                                                             ClauseView relevant_clauses) {
     SatisfiabilityResult result;
     result.satisfiable = false;
 
@@ -430,36 +1734,12 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveExtern
         return result;
     }
 
-    // Filter clauses to only those that involve target assets
-    std::vector<ClauseInfo> relevant_clauses;
-    for (const auto& clause : current_clauses) {
-        std::set<int> clause_assets;
-        collectAssetIDs(clause.expr, clause_assets);
-        
-        // Check if this clause involves any target assets
-        bool is_relevant = false;
-        for (int target_id : target_asset_ids) {
-            if (clause_assets.find(target_id) != clause_assets.end()) {
-                is_relevant = true;
-                break;
-            }
-        }
-        
-        if (is_relevant) {
-            relevant_clauses.push_back(clause);
-        }
-    }
-
     if (relevant_clauses.empty()) {
         result.satisfiable = true;
         result.assignments.push_back({}); // No relevant clauses means trivially satisfiable
         return result;
     }
 
-    // Store original clauses and replace with relevant ones
-    std::vector<ClauseInfo> original_clauses = current_clauses;
-    current_clauses = relevant_clauses;
-
     // Generate unique filenames for this litis check
     global_check_counter++;
     std::string json_filename = "witness_export_" + std::to_string(global_check_counter) + ".json";
@@ -469,7 +1749,6 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveExtern
     std::ofstream json_file(json_filename);
     if (!json_file.is_open()) {
         reportError("Could not open JSON file for writing: " + json_filename);
-        current_clauses = original_clauses; // Restore original clauses
         return result;
     }
 
@@ -522,11 +1801,7 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveExtern
         }
         
         // Get asset components from symbol table
-        std::vector<std::string> components;
-        auto it = symbol_table.find(asset_name);
-        if (it != symbol_table.end() && it->second.type_keyword == "asset") {
-            components = it->second.asset_components;
-        }
+        std::vector<std::string> components = getAssetComponentsByName(asset_name);
         
         // Get string values for components from symbol table
         std::vector<std::string> component_strings;
@@ -639,7 +1914,6 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveExtern
     
     if (exit_code != 0) {
         reportError("CUDA solver failed with exit code: " + std::to_string(exit_code));
-        current_clauses = original_clauses; // Restore original clauses
         return result;
     }
 
@@ -647,7 +1921,6 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveExtern
     std::ifstream result_file(result_filename, std::ios::binary);
     if (!result_file.is_open()) {
         reportError("Could not open result file: " + result_filename);
-        current_clauses = original_clauses; // Restore original clauses
         return result;
     }
 
@@ -667,9 +1940,6 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveExtern
     }
     result_file.close();
 
-    // Restore original clauses
-    current_clauses = original_clauses;
-
     result.satisfiable = !result.assignments.empty();
     
     if (result.satisfiable) {
@@ -681,102 +1951,131 @@ SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateSelectiveExtern
             id_to_asset[pair.second] = pair.first;
         }
         
+        // The conflict analyzer takes a clause list; a cone is copied only here
+        std::vector<ClauseInfo> storage;
+        const std::vector<ClauseInfo>& clause_list = relevant_clauses.materialize(storage);
+        
         // Use conflict analyzer to find minimal conflicting set
-        std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(relevant_clauses, id_to_asset);
-        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, id_to_asset);
+        std::vector<std::string> conflicting_clauses = conflict_analyzer->findMinimalConflictingSet(clause_list, id_to_asset);
+        std::string conflict_report = conflict_analyzer->generateConflictReport(conflicting_clauses, clause_list, id_to_asset);
         
         result.error_message = "External solver mode: No satisfying assignments found for selected assets";
         result.conflicting_clauses = conflicting_clauses;
         
         reportError(result.error_message);
         std::cout << "\n" << conflict_report << std::endl;
+        reportConflictEnumeration(clause_list, id_to_asset);
     }
 
     return result;
 }
 
+bool SemanticAnalyzer::meetOperandClauses(const std::string& operand, std::vector<ClauseInfo>& clauses) {
+    for (const auto& clause : current_clauses) {
+        if (clause.name == operand) clauses.push_back(clause);
+    }
+    if (!clauses.empty()) return true;
+
+    TypeInfo* info = lookupType(operand);
+    if (!info || info->type_keyword != "asset") return false;
+    getOrAssignAssetID(operand);
+    // The product below joins both operands' clauses, so the cone is copied out
+    for (size_t i : relevantClauseIndices({operand})) {
+        clauses.push_back(current_clauses[i]);
+    }
+    return true;
+}
+
 SemanticAnalyzer::SatisfiabilityResult SemanticAnalyzer::generateMeetAnalysis(const std::string& left_asset, const std::string& right_asset) {
     SatisfiabilityResult result;
     result.satisfiable = false;
 
-    // Get the asset components for both assets
-    TypeInfo* left_info = lookupType(left_asset);
-    TypeInfo* right_info = lookupType(right_asset);
-    
-    if (!left_info || left_info->type_keyword != "asset") {
-        result.error_message = "Asset '" + left_asset + "' not found or not a valid asset";
-        return result;
-    }
-    
-    if (!right_info || right_info->type_keyword != "asset") {
-        result.error_message = "Asset '" + right_asset + "' not found or not a valid asset";
+    std::vector<ClauseInfo> left_clauses;
+    std::vector<ClauseInfo> right_clauses;
+    if (!meetOperandClauses(left_asset, left_clauses)) {
+        result.error_message = "'" + left_asset + "' is neither a clause of the current block nor an asset";
         return result;
     }
-    
-    const std::vector<std::string>& left_components = left_info->asset_components;
-    const std::vector<std::string>& right_components = right_info->asset_components;
-    
-    if (left_components.size() < 3 || right_components.size() < 3) {
-        result.error_message = "Assets must have at least 3 components (subject, action, object)";
+    if (!meetOperandClauses(right_asset, right_clauses)) {
+        result.error_message = "'" + right_asset + "' is neither a clause of the current block nor an asset";
         return result;
     }
-    
-    // Extract common elements between the two assets
-    std::vector<std::string> common_elements;
-    
-    // Check for common subjects
-    if (left_components[0] == right_components[0]) {
-        common_elements.push_back("subject: " + left_components[0]);
+
+    // One diagram over every asset either operand mentions; asset operands
+    // no clause constrains are free variables
+    std::vector<ClauseInfo> both = left_clauses;
+    both.insert(both.end(), right_clauses.begin(), right_clauses.end());
+    std::unordered_map<std::string, int> var_of;
+    std::vector<int> asset_ids = diagramVariables(both, var_of);
+    for (const auto& operand : {left_asset, right_asset}) {
+        auto it = asset_to_id.find(operand);
+        if (it != asset_to_id.end() && !var_of.count(operand)) {
+            var_of[operand] = static_cast<int>(asset_ids.size());
+            asset_ids.push_back(it->second);
+        }
     }
-    
-    // Check for common objects
-    if (left_components[2] == right_components[2]) {
-        common_elements.push_back("object: " + left_components[2]);
+
+    Bdd bdd(static_cast<int>(asset_ids.size()));
+    Bdd::Node left = Bdd::True;
+    for (const auto& clause : left_clauses) {
+        left = bdd.conjoin(left, bdd.compile(clause.expr, var_of));
     }
-    
-    // Check for common actions (or similar actions)
-    if (left_components[1] == right_components[1]) {
-        common_elements.push_back("action: " + left_components[1]);
+    Bdd::Node right = Bdd::True;
+    for (const auto& clause : right_clauses) {
+        right = bdd.conjoin(right, bdd.compile(clause.expr, var_of));
     }
-    
-    // Check for cross-subject/object relationships
-    if (left_components[0] == right_components[2]) {
-        common_elements.push_back("subject-object: " + left_components[0] + " ↔ " + right_components[2]);
+    Bdd::Node meet = bdd.conjoin(left, right);
+    if (bdd.overflowed()) {
+        result.error_message = "Meet analysis: decision diagram exceeded its node limit";
+        return result;
     }
-    
-    if (left_components[2] == right_components[0]) {
-        common_elements.push_back("object-subject: " + left_components[2] + " ↔ " + right_components[0]);
+
+    BigCount total = bdd.countModels(meet);
+    std::string sizes = "'" + left_asset + "' has " + bdd.countModels(left).toString() + " models, '" + right_asset +
+                        "' has " + bdd.countModels(right).toString() + " over " + std::to_string(asset_ids.size()) + " assets";
+    if (total.isZero()) {
+        result.error_message = "Meet analysis: no common legal ground - " + sizes;
+        return result;
     }
-    
-    // Create a result representing the common elements
-    if (!common_elements.empty()) {
-        result.satisfiable = true;
-        result.error_message = "Meet analysis: Found " + std::to_string(common_elements.size()) + " common elements";
-        
-        // Create a symbolic assignment representing the common elements
-        std::vector<int> common_assignment;
-        for (const auto& element : common_elements) {
-            // Use a hash of the element as a symbolic ID
-            std::hash<std::string> hasher;
-            int element_id = static_cast<int>(hasher(element)) % 1000; // Keep it reasonable
-            common_assignment.push_back(element_id);
-        }
-        result.assignments.push_back(common_assignment);
-        
-        // Report the common elements
-        reportWarning("Common elements between '" + left_asset + "' and '" + right_asset + "':");
-        for (const auto& element : common_elements) {
-            reportWarning("  - " + element);
+
+    std::unordered_map<int, std::string> id_to_asset;
+    for (const auto& pair : asset_to_id) {
+        id_to_asset[pair.second] = pair.first;
+    }
+
+    // Representative: follow the false branch wherever it still has models
+    std::vector<bool> representative(asset_ids.size(), false);
+    for (Bdd::Node node = meet; node > Bdd::True;) {
+        bool take_high = bdd.low(node) == Bdd::False;
+        representative[bdd.level(node)] = take_high;
+        node = take_high ? bdd.high(node) : bdd.low(node);
+    }
+
+    // Fixed assets take one value in every common model
+    std::vector<BigCount> counts = bdd.marginalCounts(meet);
+    std::string representative_text;
+    std::string fixed_text;
+    std::vector<int> model;
+    for (size_t i = 0; i < asset_ids.size(); i++) {
+        const std::string& name = id_to_asset[asset_ids[i]];
+        model.push_back(representative[i] ? asset_ids[i] : -asset_ids[i]);
+        representative_text += (i > 0 ? ", " : "") + name + " = " + (representative[i] ? "true" : "false");
+        if (counts[i].isZero() || counts[i] == total) {
+            std::string fixed = name + " = " + (counts[i].isZero() ? "false" : "true");
+            fixed_text += (fixed_text.empty() ? "" : ", ") + fixed;
+            result.common_components.push_back(fixed);
         }
-        
-        // Store the common components for asset creation
-        result.common_components = common_elements;
-    } else {
-        result.error_message = "Meet analysis: No common elements found between '" + left_asset + "' and '" + right_asset + "'";
-        reportWarning("No common elements found between assets:");
-        reportWarning("  Left:  (" + left_components[0] + ", " + left_components[1] + ", " + left_components[2] + ")");
-        reportWarning("  Right: (" + right_components[0] + ", " + right_components[1] + ", " + right_components[2] + ")");
     }
+    std::sort(model.begin(), model.end(), [](int a, int b) { return std::abs(a) < std::abs(b); });
+    result.assignments.push_back(model);
+
+    result.satisfiable = true;
+    result.error_message = "Meet analysis: " + total.toString() + " common models - " + sizes;
+    reportWarning(result.error_message);
+    std::cout << "Meet of '" << left_asset << "' and '" << right_asset << "': " << total.toString()
+              << " common models over " << asset_ids.size() << " assets" << std::endl;
+    std::cout << "  Representative: " << representative_text << std::endl;
+    std::cout << "  Fixed: " << (fixed_text.empty() ? "none" : fixed_text) << std::endl;
 
     return result;
 }
@@ -821,7 +2120,7 @@ void SemanticAnalyzer::processDeferredMeetOperations() {
         }
         
         // Reset clause set for next operation
-        current_clauses.clear();
+        clearClauses();
         reportWarning("Clause set reset after deferred meet() operation.");
     }
     
@@ -1003,6 +2302,9 @@ void SemanticAnalyzer::analyze(Program* program) {
     errors.clear();
     warnings.clear();
     symbol_table.clear();
+    resolved_components.clear();
+    join_labels.clear();
+    longest_action_name = 0;
     
     // First pass: Build symbol table from type definitions
     for (auto& stmt : program->statements) {
@@ -1029,6 +2331,18 @@ void SemanticAnalyzer::analyze(Program* program) {
         }
     }
     
+    // Clauses after the last system operation still constrain the contract
+    if (collectBlocksOnly) {
+        collectBlock("trailing clauses", current_clauses);
+    }
+    
+    if (suggestJoins && !collectBlocksOnly) {
+        reportJoinSuggestions(program);
+    }
+    if (!collectBlocksOnly) {
+        reportAttributeQueries();
+    }
+    
     // Report analysis results
     if (!errors.empty() && !quiet) {
         std::cout << "Semantic Analysis Errors:" << std::endl;
@@ -1050,7 +2364,7 @@ void SemanticAnalyzer::analyze(Program* program) {
     if (!quiet) {
         if (errors.empty()) {
             std::cout << "Semantic analysis completed successfully!" << std::endl;
-            std::cout << "- System operations validated: global(), domain(), litis(), meet()" << std::endl;
+            std::cout << "- System operations validated: global(), domain(), litis(), meet(), entails(), party()" << std::endl;
             std::cout << "- Join operations validated: transfer, sell, compensation, consideration, forbearance, encumber" << std::endl;
             std::cout << "- Logical operations validated: oblig(), claim(), not()" << std::endl;
         } else {
@@ -1082,6 +2396,9 @@ void SemanticAnalyzer::registerTypeDefinition(TypeDefinition* type_def) {
     } else {
         symbol_table[name] = TypeInfo(type_def->type_keyword, constraint);
     }
+    if (type_def->type_keyword == "action") {
+        longest_action_name = std::max(longest_action_name, name.size());
+    }
 }
 
 void SemanticAnalyzer::registerAssetDefinition(AssetDefinition* asset_def) {
@@ -1089,6 +2406,7 @@ void SemanticAnalyzer::registerAssetDefinition(AssetDefinition* asset_def) {
     
     std::string name = asset_def->name->name;
     std::vector<std::string> components;
+    int action_label = -1;
     
     // Check if this is a join operation (single function call)
     if (asset_def->value->expressions.size() == 1) {
@@ -1104,8 +2422,8 @@ void SemanticAnalyzer::registerAssetDefinition(AssetDefinition* asset_def) {
                     auto right_arg = func_call->arguments->expressions[1].get();
                     
                     // Get components from left and right assets
-                    auto left_components = getAssetComponents(left_arg);
-                    auto right_components = getAssetComponents(right_arg);
+                    const auto& left_components = getAssetComponents(left_arg);
+                    const auto& right_components = getAssetComponents(right_arg);
                     
                     // Debug: Report component sizes
                     reportWarning("Join validation for '" + name + "': left_components.size()=" + 
@@ -1113,24 +2431,23 @@ void SemanticAnalyzer::registerAssetDefinition(AssetDefinition* asset_def) {
                                  std::to_string(right_components.size()));
                     
                     if (left_components.size() >= 3 && right_components.size() >= 3) {
-                        // Create combined components based on join type
-                        if (join_type == "join") {
-                            // Universal join: combine subject and object, merge actions
-                            components.push_back(left_components[0]); // left subject
-                            components.push_back(left_components[1] + "_" + right_components[1]); // combined action
-                            components.push_back(left_components[2]); // left object
-                        } else {
-                            // For other join types, use the same pattern for now
-                            components.push_back(left_components[0]); // left subject
-                            components.push_back(join_type + "_" + left_components[1] + "_" + right_components[1]); // join_type + combined action
-                            components.push_back(left_components[2]); // left object
-                        }
+                        // Combine subject and object; the combined action is interned
+                        // from the operands' labels rather than copied out of them
+                        components.push_back(left_components[0]); // left subject
+                        components.push_back(""); // combined action, held by action_label
+                        components.push_back(left_components[2]); // left object
+                        // Universal join: merge actions; other join types prefix the join type
+                        std::string prefix = join_type == "join" ? "" : join_type + "_";
+                        action_label = join_labels.join(prefix, actionLabel(left_arg), actionLabel(right_arg));
                         
-                        reportWarning("Join asset '" + name + "' created with components: (" + 
-                                     components[0] + ", " + components[1] + ", " + components[2] + ")");
+                        // Spelling out the label costs its length, so only for a warning that is printed
+                        if (!quiet) {
+                            reportWarning("Join asset '" + name + "' created with components: (" + 
+                                         components[0] + ", " + join_labels.text(action_label) + ", " + components[2] + ")");
+                        }
                         
                         // Debug: Check if components are valid
-                        if (components[0].empty() || components[1].empty() || components[2].empty()) {
+                        if (components[0].empty() || join_labels.length(action_label) == 0 || components[2].empty()) {
                             reportError("Join asset '" + name + "' has empty components - this will cause issues");
                         }
                     } else {
@@ -1213,6 +2530,8 @@ void SemanticAnalyzer::registerAssetDefinition(AssetDefinition* asset_def) {
     
     // Store the asset with its components
     symbol_table[name] = TypeInfo("asset", "", components);
+    symbol_table[name].action_label = action_label;
+    component_lattice.addAsset(name, latticeComponents(components, action_label));
 }
 
 TypeInfo* SemanticAnalyzer::lookupType(const std::string& identifier) {
@@ -1362,9 +2681,9 @@ bool SemanticAnalyzer::validateJoinAssociativity(const std::string& join_type,
                 auto left_right = left_func_call->arguments->expressions[1].get();
                 
                 // Get components for associativity check
-                auto left_left_components = getAssetComponents(left_left);
-                auto left_right_components = getAssetComponents(left_right);
-                auto right_components = getAssetComponents(right_asset);
+                const auto& left_left_components = getAssetComponents(left_left);
+                const auto& left_right_components = getAssetComponents(left_right);
+                const auto& right_components = getAssetComponents(right_asset);
                 
                 // For associativity, we need to check if the join type supports it
                 // Most join operations are associative, but some contextual joins may not be
@@ -1397,9 +2716,9 @@ bool SemanticAnalyzer::validateJoinAssociativity(const std::string& join_type,
                 auto right_right = right_func_call->arguments->expressions[1].get();
                 
                 // Get components for associativity check
-                auto left_components = getAssetComponents(left_asset);
-                auto right_left_components = getAssetComponents(right_left);
-                auto right_right_components = getAssetComponents(right_right);
+                const auto& left_components = getAssetComponents(left_asset);
+                const auto& right_left_components = getAssetComponents(right_left);
+                const auto& right_right_components = getAssetComponents(right_right);
                 
                 // Similar validation as above
                 if (join_type == "join" || join_type == "evidence" || join_type == "argument") {
@@ -1489,6 +2808,10 @@ bool SemanticAnalyzer::validateSystemOperation(const std::string& operation_type
         return validateMeetOperation(func_call, "");
     } else if (operation_type == "domain") {
         return validateDomainOperation(func_call);
+    } else if (operation_type == "entails") {
+        return validateEntailsOperation(func_call);
+    } else if (operation_type == "party") {
+        return validatePartyOperation(func_call);
     }
     
     reportError("Unknown system operation: " + operation_type);
@@ -1603,7 +2926,15 @@ void SemanticAnalyzer::analyzeClauseDefinition(ClauseDefinition* clause_def) {
     // Analyze the clause expression and collect clauses for satisfiability checking
     if (clause_def->expression) {
         std::string clause_name = clause_def->name ? clause_def->name->name : "unnamed_clause";
+        size_t first_new = current_clauses.size();
         analyzeClauseExpression(clause_def->expression.get(), clause_name);
+        
+        // Clauses registered for this definition carry its priority annotation and position
+        for (size_t i = first_new; i < current_clauses.size(); i++) {
+            current_clauses[i].weight = clause_def->weight;
+            current_clauses[i].line = clause_def->line;
+            current_clauses[i].column = clause_def->column;
+        }
     }
 }
 
@@ -1815,6 +3146,113 @@ bool SemanticAnalyzer::validateLienJoin(Expression* left, Expression* right) {
     return true;
 }
 
+void SemanticAnalyzer::reportAttributeQueries() {
+    static const char* role_names[] = {"subject", "action", "object"};
+    for (const auto& query : attribute_queries) {
+        // Joined action labels are keyed by their interned ID in the lattice
+        ConceptLattice::Attributes keyed = query;
+        for (auto& attribute : keyed) {
+            if (attribute.first != ConceptLattice::Action) continue;
+            int label = join_labels.find(attribute.second);
+            if (label >= 0 && join_labels.isJoined(label)) attribute.second = "\x01" + std::to_string(label);
+        }
+        std::vector<std::string> assets = component_lattice.assetsWith(keyed);
+        std::cout << "Assets with ";
+        for (size_t i = 0; i < query.size(); i++) {
+            std::cout << (i > 0 ? ", " : "") << role_names[query[i].first] << "=" << query[i].second;
+        }
+        std::cout << " (" << assets.size() << " of " << component_lattice.assetCount() << "): {";
+        for (size_t i = 0; i < assets.size(); i++) {
+            std::cout << (i > 0 ? ", " : "") << assets[i];
+        }
+        std::cout << "}" << std::endl;
+    }
+}
+
+void SemanticAnalyzer::reportJoinSuggestions(Program* program) {
+    // Underlying type of each asset, resolved once: 0 movable object,
+    // 1 non-movable object, 2 positive service, 3 negative service
+    struct Candidate {
+        std::string name;
+        const std::vector<std::string>* components;
+        int category;
+    };
+    static const std::pair<std::string, std::string> categories[] = {
+        {"object", "movable"}, {"object", "non_movable"}, {"service", "positive"}, {"service", "negative"}};
+    std::vector<Candidate> assets;
+    for (auto& stmt : program->statements) {
+        auto asset_def = dynamic_cast<AssetDefinition*>(stmt.get());
+        if (!asset_def || !asset_def->name) continue;
+        TypeInfo* asset_info = lookupType(asset_def->name->name);
+        if (!asset_info || asset_info->type_keyword != "asset" || asset_info->asset_components.size() < 3) continue;
+        int category = -1;
+        for (int k = 0; k < 4 && category < 0; k++) {
+            if (analyzeAssetForTypeConstraint(asset_def->name->name, categories[k].first, categories[k].second)) {
+                category = k;
+            }
+        }
+        if (category >= 0) {
+            assets.push_back({asset_def->name->name, &asset_info->asset_components, category});
+        }
+    }
+    
+    // Left and right categories accepted by each contextual join, as in its validator
+    static const struct {
+        const char* join_type;
+        unsigned left;
+        unsigned right;
+    } signatures[] = {
+        {"transfer", 0b0001, 0b0001},
+        {"sell", 0b0011, 0b0100},
+        {"compensation", 0b0100, 0b0100},
+        {"consideration", 0b0100, 0b1000},
+        {"forbearance", 0b1000, 0b1000},
+        {"encumber", 0b0010, 0b0100},
+        {"access", 0b0010, 0b0100},
+        {"lien", 0b0010, 0b1000},
+    };
+    
+    // (s1, A1, s2) pairs with every (s2, A2, s1): bucket by (subject, object),
+    // then probe each asset's reciprocal key
+    std::unordered_map<std::string, std::vector<size_t>> by_parties;
+    auto partiesKey = [](const std::string& subject, const std::string& object) {
+        return subject + '\0' + object;
+    };
+    for (size_t i = 0; i < assets.size(); i++) {
+        const auto& components = *assets[i].components;
+        by_parties[partiesKey(components[0], components[2])].push_back(i);
+    }
+    std::vector<std::vector<std::string>> suggestions(sizeof(signatures) / sizeof(signatures[0]));
+    size_t total = 0;
+    for (size_t i = 0; i < assets.size(); i++) {
+        const auto& components = *assets[i].components;
+        auto it = by_parties.find(partiesKey(components[2], components[0]));
+        if (it == by_parties.end()) continue;
+        for (size_t j : it->second) {
+            if (j == i) continue;
+            for (size_t k = 0; k < suggestions.size(); k++) {
+                if ((signatures[k].left >> assets[i].category & 1) && (signatures[k].right >> assets[j].category & 1)) {
+                    suggestions[k].push_back(std::string(signatures[k].join_type) + "(" + assets[i].name + ", " +
+                                             assets[j].name + ")");
+                    total++;
+                }
+            }
+        }
+    }
+    
+    std::cout << "Join suggestions (" << total << " candidates across " << assets.size() << " typed assets):" << std::endl;
+    if (total == 0) {
+        std::cout << "  No reciprocal asset pairs satisfy a contextual join" << std::endl;
+    }
+    for (size_t k = 0; k < suggestions.size(); k++) {
+        if (suggestions[k].empty()) continue;
+        std::cout << "  " << signatures[k].join_type << " (" << suggestions[k].size() << "):" << std::endl;
+        for (const auto& suggestion : suggestions[k]) {
+            std::cout << "    " << suggestion << std::endl;
+        }
+    }
+}
+
 // Asset analysis helpers
 
 bool SemanticAnalyzer::isAssetExpression(Expression* expr) {
@@ -1826,8 +3264,8 @@ bool SemanticAnalyzer::isAssetExpression(Expression* expr) {
     return false;
 }
 
-std::vector<std::string> SemanticAnalyzer::getAssetComponents(Expression* asset) {
-    std::vector<std::string> components;
+const std::vector<std::string>& SemanticAnalyzer::getAssetComponents(Expression* asset) {
+    static const std::vector<std::string> no_components;
     
     if (auto identifier = dynamic_cast<Identifier*>(asset)) {
         // Look up the asset in the symbol table
@@ -1835,11 +3273,17 @@ std::vector<std::string> SemanticAnalyzer::getAssetComponents(Expression* asset)
         if (asset_info && asset_info->type_keyword == "asset") {
             return asset_info->asset_components;
         }
+        return no_components;
     }
     
     // If it's an expression list, extract components directly
     // This would be for inline asset definitions like: alice, "sell", bob
     if (auto expr_list = dynamic_cast<ExpressionList*>(asset)) {
+        auto cached = resolved_components.find(asset);
+        if (cached != resolved_components.end()) {
+            return cached->second;
+        }
+        std::vector<std::string>& components = resolved_components[asset];
         for (const auto& expr : expr_list->expressions) {
             if (auto id = dynamic_cast<Identifier*>(expr.get())) {
                 components.push_back(id->name);
@@ -1847,23 +3291,57 @@ std::vector<std::string> SemanticAnalyzer::getAssetComponents(Expression* asset)
                 components.push_back(str_lit->value);
             }
         }
+        return components;
     }
     
-    return components;
+    return no_components;
+}
+
+int SemanticAnalyzer::actionLabel(Expression* asset) {
+    if (auto identifier = dynamic_cast<Identifier*>(asset)) {
+        TypeInfo* asset_info = lookupType(identifier->name);
+        if (asset_info && asset_info->action_label >= 0) {
+            return asset_info->action_label;
+        }
+    }
+    return join_labels.intern(getAssetComponents(asset)[1]);
+}
+
+std::string SemanticAnalyzer::actionText(const TypeInfo& asset_info) const {
+    if (asset_info.action_label >= 0) {
+        return join_labels.text(asset_info.action_label);
+    }
+    return asset_info.asset_components.size() > 1 ? asset_info.asset_components[1] : "";
+}
+
+std::vector<std::string> SemanticAnalyzer::latticeComponents(const std::vector<std::string>& components, int action_label) {
+    if (components.size() < 3) return components;
+    // Plain actions are interned too, so one spelled the same as a joined
+    // label lands on the same attribute whichever was registered first
+    int label = action_label >= 0 ? action_label : join_labels.intern(components[1]);
+    std::vector<std::string> keyed = components;
+    keyed[1] = join_labels.isJoined(label) ? "\x01" + std::to_string(label) : components[1];
+    return keyed;
 }
 
 std::string SemanticAnalyzer::getAssetSubject(Expression* asset) {
-    auto components = getAssetComponents(asset);
+    const auto& components = getAssetComponents(asset);
     return components.size() > 0 ? components[0] : "";
 }
 
 std::string SemanticAnalyzer::getAssetAction(Expression* asset) {
-    auto components = getAssetComponents(asset);
+    if (auto identifier = dynamic_cast<Identifier*>(asset)) {
+        TypeInfo* asset_info = lookupType(identifier->name);
+        if (asset_info && asset_info->action_label >= 0) {
+            return actionText(*asset_info);
+        }
+    }
+    const auto& components = getAssetComponents(asset);
     return components.size() > 1 ? components[1] : "";
 }
 
 std::string SemanticAnalyzer::getAssetObject(Expression* asset) {
-    auto components = getAssetComponents(asset);
+    const auto& components = getAssetComponents(asset);
     return components.size() > 2 ? components[2] : "";
 }
 
@@ -1952,8 +3430,8 @@ bool SemanticAnalyzer::isReciprocalPattern(Expression* left, Expression* right)
     }
     
     // Get asset components [subject, action, object]
-    auto left_components = getAssetComponents(left);
-    auto right_components = getAssetComponents(right);
+    const auto& left_components = getAssetComponents(left);
+    const auto& right_components = getAssetComponents(right);
     
     // Both assets must have at least 3 components (subject, action, object)
     if (left_components.size() < 3 || right_components.size() < 3) {
@@ -1980,13 +3458,13 @@ std::string SemanticAnalyzer::getDetailedJoinError(const std::string& join_type,
     std::string error = "Join operation '" + join_type + "' failed:\n";
     
     // Get asset components for detailed analysis
-    auto left_components = getAssetComponents(left);
-    auto right_components = getAssetComponents(right);
+    const auto& left_components = getAssetComponents(left);
+    const auto& right_components = getAssetComponents(right);
     
     if (auto left_id = dynamic_cast<Identifier*>(left)) {
         error += "  Left asset: " + left_id->name;
         if (left_components.size() >= 3) {
-            error += " = (" + left_components[0] + ", " + left_components[1] + ", " + left_components[2] + ")";
+            error += " = (" + left_components[0] + ", " + getAssetAction(left) + ", " + left_components[2] + ")";
         }
         error += "\n";
     }
@@ -1994,7 +3472,7 @@ std::string SemanticAnalyzer::getDetailedJoinError(const std::string& join_type,
     if (auto right_id = dynamic_cast<Identifier*>(right)) {
         error += "  Right asset: " + right_id->name;
         if (right_components.size() >= 3) {
-            error += " = (" + right_components[0] + ", " + right_components[1] + ", " + right_components[2] + ")";
+            error += " = (" + right_components[0] + ", " + getAssetAction(right) + ", " + right_components[2] + ")";
         }
         error += "\n";
     }
@@ -2029,8 +3507,12 @@ bool SemanticAnalyzer::analyzeAssetForTypeConstraint(const std::string& asset_na
         return false;
     }
     
-    // The action is typically the second component
-    std::string action_name = asset_info->asset_components[1];
+    // The action is typically the second component. A joined label can only
+    // name an action as long as some action name, so longer ones stay unspelled
+    if (asset_info->action_label >= 0 && join_labels.length(asset_info->action_label) > longest_action_name) {
+        return false;
+    }
+    std::string action_name = actionText(*asset_info);
     
     // Look up the action in the symbol table
     TypeInfo* action_info = lookupType(action_name);
@@ -2167,10 +3649,38 @@ bool SemanticAnalyzer::validateGlobalOperation(FunctionCallExpression* func_call
         return false;
     }
     
+    if (collectBlocksOnly) {
+        collectBlock("global()", current_clauses);
+        clearClauses();
+        return true;
+    }
+    
+    if (lintRedundant) {
+        reportClauseLint(current_clauses);
+    }
+    if (clauseImpact) {
+        reportClauseImpact(current_clauses);
+    }
+    reportLitisQueries();
+    reportPartyProjections();
+    
     // Trigger truth table generation for satisfiability checking
     reportWarning("global() operation triggered - generating truth table...");
     
-    SatisfiabilityResult result = generateTruthTable();
+    SatisfiabilityResult result;
+    bool reported = reportsDecideSatisfiability();
+    bool decided = reported && decideWithoutEnumeration(current_clauses, result);
+    bool paged = false;
+    if (!decided && models_page_count > 0 && optimizeQuery.empty() && modelsMode == "all" && !current_clauses.empty()) {
+        std::set<int> block_asset_ids;
+        for (const auto& ids : clause_asset_ids) {
+            block_asset_ids.insert(ids.begin(), ids.end());
+        }
+        paged = generatePagedTruthTable(current_clauses, std::vector<int>(block_asset_ids.begin(), block_asset_ids.end()), result);
+    }
+    if (!decided && !paged) {
+        result = generateTruthTable();
+    }
     
     if (result.satisfiable) {
         reportWarning("global() operation successful - system is satisfiable");
@@ -2193,6 +3703,13 @@ bool SemanticAnalyzer::validateGlobalOperation(FunctionCallExpression* func_call
             reportWarning(assignment_str);
         }
         std::cout << "Global check SATISFIABLE" << std::endl;
+        if (backboneMode && !reported) {
+            reportBackbone(current_clauses);
+        }
+        bool diagram_satisfiable = true;
+        if (marginalsMode && !reported) {
+            reportMarginals(current_clauses, diagram_satisfiable);
+        }
     } else {
         reportError("global() operation failed - system is unsatisfiable: " + result.error_message);
         std::cout << "Global check UNSATISFIABLE: " << result.error_message << std::endl;
@@ -2200,7 +3717,7 @@ bool SemanticAnalyzer::validateGlobalOperation(FunctionCallExpression* func_call
     }
     
     // Reset clause set for next global block
-    current_clauses.clear();
+    clearClauses();
     reportWarning("Clause set reset after global() operation.");
     return true;
 }
@@ -2246,12 +3763,51 @@ bool SemanticAnalyzer::validateLitisOperation(FunctionCallExpression* func_call)
                       return result;
                   }());
     
+    // One cone per litis(), shared by every engine and report below as a view
+    // over the block; ClauseInfo copies are made only for the conflict analyzer
+    std::vector<size_t> cone = relevantClauseIndices(target_assets);
+    ClauseView relevant_clauses(current_clauses, cone);
+    
+    if (collectBlocksOnly) {
+        collectBlock("litis()", relevant_clauses);
+        clearClauses();
+        return true;
+    }
+    
+    if (lintRedundant) {
+        reportClauseLint(relevant_clauses);
+    }
+    if (clauseImpact) {
+        reportClauseImpact(relevant_clauses);
+    }
+    
     // Perform selective satisfiability checking based on solver mode
+    std::string engine = solverMode;
+    if (engine == "auto" && modelsMode != "minimal" && optimizeQuery.empty()) {
+        engine = selectEngine(relevant_clauses);
+    }
+    
     SatisfiabilityResult result;
-    if (solverMode == "external") {
-        result = generateSelectiveExternalTruthTable(target_assets);
+    bool reported = reportsDecideSatisfiability();
+    bool decided = reported && decideWithoutEnumeration(relevant_clauses, result);
+    bool paged = false;
+    if (!decided && models_page_count > 0 && optimizeQuery.empty() && modelsMode == "all" && !relevant_clauses.empty()) {
+        paged = generatePagedTruthTable(relevant_clauses, projectionAssetIDs(relevant_clauses, target_assets), result);
+    }
+    if (decided || paged) {
+        // Already decided and reported
+    } else if (!optimizeQuery.empty()) {
+        result = generateOptimalTruthTable(relevant_clauses);
+    } else if (modelsMode == "minimal") {
+        result = generateMinimalModelTruthTable(relevant_clauses);
+    } else if (engine == "external") {
+        result = generateSelectiveExternalTruthTable(target_assets, relevant_clauses);
+    } else if (engine == "sat") {
+        result = generateSelectiveTruthTable(target_assets, relevant_clauses, "Selective SAT enumeration");
+    } else if (engine == "portfolio") {
+        result = generatePortfolioTruthTable(relevant_clauses);
     } else {
-        result = generateSelectiveTruthTable(target_assets);
+        result = generateSelectiveTruthTable(target_assets, relevant_clauses, "Selective truth table generation");
     }
     
     if (result.satisfiable) {
@@ -2275,6 +3831,13 @@ bool SemanticAnalyzer::validateLitisOperation(FunctionCallExpression* func_call)
             reportWarning(assignment_str);
         }
         std::cout << "Litis check SATISFIABLE" << std::endl;
+        if (backboneMode && !reported) {
+            reportBackbone(relevant_clauses);
+        }
+        bool diagram_satisfiable = true;
+        if (marginalsMode && !reported) {
+            reportMarginals(relevant_clauses, diagram_satisfiable);
+        }
     } else {
         reportError("litis() operation failed - selected assets are unsatisfiable: " + result.error_message);
         std::cout << "Litis check UNSATISFIABLE: " << result.error_message << std::endl;
@@ -2282,7 +3845,7 @@ bool SemanticAnalyzer::validateLitisOperation(FunctionCallExpression* func_call)
     }
     
     // Reset clause set for next operation
-    current_clauses.clear();
+    clearClauses();
     reportWarning("Clause set reset after litis() operation.");
     return true;
 }
@@ -2326,57 +3889,42 @@ bool SemanticAnalyzer::validateMeetOperation(FunctionCallExpression* func_call,
         return false;
     }
     
-    // Perform meet operation analysis for greatest common legal denominator extraction
+    // Definition pass: register the meet asset so later statements can use it.
+    // Its parties are the ones both operands share (a lattice lookup), "shared" otherwise
+    if (!asset_name.empty()) {
+        std::vector<std::string> asset_components = {"shared", "meet", "shared"};
+        const ConceptLattice::Concept* shared = component_lattice.meet(left_asset_name, right_asset_name);
+        if (shared && !shared->intent.empty()) {
+            std::string subject = component_lattice.roleValue(*shared, ConceptLattice::Subject);
+            std::string object = component_lattice.roleValue(*shared, ConceptLattice::Object);
+            if (!subject.empty()) asset_components[0] = subject;
+            if (!object.empty()) asset_components[2] = object;
+            reportWarning("Components shared by '" + left_asset_name + "' and '" + right_asset_name + "' are carried by " +
+                          std::to_string(component_lattice.extentNames(shared->extent).size()) + " assets");
+        }
+        symbol_table[asset_name] = TypeInfo("asset", "", asset_components);
+        component_lattice.addAsset(asset_name, latticeComponents(asset_components, -1));
+        reportWarning("Created meet asset '" + asset_name + "' with components: (" + 
+                     asset_components[0] + ", " + asset_components[1] + ", " + asset_components[2] + ")");
+        return true;
+    }
+    
+    if (current_clauses.empty() || collectBlocksOnly) {
+        reportWarning("meet() operation skipped - no clauses in the current block");
+        return true;
+    }
+    
+    // Intersect the operands' solution spaces in the current block
     reportWarning("meet() operation triggered - extracting greatest common legal denominator from: " + 
                   left_asset_name + " and " + right_asset_name);
     
-    // Perform meet operation analysis
     SatisfiabilityResult result = generateMeetAnalysis(left_asset_name, right_asset_name);
     
     if (result.satisfiable) {
-        reportWarning("meet() operation successful - common elements found");
-        
-        // Create a new asset from the common components
-        if (!asset_name.empty() && !result.common_components.empty()) {
-            // Create a simplified asset representation from common elements
-            std::vector<std::string> asset_components;
-            
-            // Extract common subject, action, and object from common elements
-            std::string common_subject = "";
-            std::string common_action = "meet";
-            std::string common_object = "";
-            
-            for (const auto& element : result.common_components) {
-                if (element.find("subject: ") == 0) {
-                    common_subject = element.substr(9); // Remove "subject: " prefix
-                } else if (element.find("object: ") == 0) {
-                    common_object = element.substr(8); // Remove "object: " prefix
-                } else if (element.find("subject-object: ") == 0) {
-                    // Handle cross-relationship
-                    std::string relationship = element.substr(15); // Remove "subject-object: " prefix
-                    size_t arrow_pos = relationship.find(" ↔ ");
-                    if (arrow_pos != std::string::npos) {
-                        common_subject = relationship.substr(0, arrow_pos);
-                        common_object = relationship.substr(arrow_pos + 3);
-                    }
-                }
-            }
-            
-            // Always create an asset with exactly 3 components
-            asset_components.push_back(common_subject.empty() ? "shared" : common_subject);
-            asset_components.push_back(common_action);
-            asset_components.push_back(common_object.empty() ? "shared" : common_object);
-            
-            // Register the new meet asset in the symbol table
-            symbol_table[asset_name] = TypeInfo("asset", "", asset_components);
-            
-            reportWarning("Created meet asset '" + asset_name + "' with components: (" + 
-                         asset_components[0] + ", " + asset_components[1] + ", " + asset_components[2] + ")");
-        }
-        
+        reportWarning("meet() operation successful - common legal ground found");
         std::cout << "Meet check SATISFIABLE" << std::endl;
     } else {
-        reportError("meet() operation failed - no common elements found: " + result.error_message);
+        reportError("meet() operation failed - no common legal ground found: " + result.error_message);
         std::cout << "Meet check UNSATISFIABLE: " << result.error_message << std::endl;
         return false;
     }
@@ -2398,103 +3946,176 @@ bool SemanticAnalyzer::validateDomainOperation(FunctionCallExpression* func_call
     }
     
     // All arguments should be valid asset identifiers
+    std::vector<std::string> domain_assets;
     for (const auto& arg : func_call->arguments->expressions) {
         if (!arg) {
             reportError("domain() operation requires valid asset arguments");
             return false;
         }
+        auto identifier = dynamic_cast<Identifier*>(arg.get());
+        if (!identifier) {
+            reportError("domain() operation requires asset identifier arguments");
+            return false;
+        }
+        TypeInfo* asset_info = lookupType(identifier->name);
+        if (!asset_info || asset_info->type_keyword != "asset") {
+            reportError("domain() operation requires defined asset arguments (got '" + identifier->name + "')");
+            return false;
+        }
+        domain_assets.push_back(identifier->name);
+    }
+    
+    if (current_clauses.empty() || collectBlocksOnly) {
+        reportWarning("domain() operation skipped - no clauses in the current block");
+        return true;
+    }
+    
+    // Assets the block never mentions are free without asking the solver
+    std::vector<int> asset_ids;
+    for (const auto& asset_name : domain_assets) {
+        auto it = asset_to_id.find(asset_name);
+        if (it != asset_to_id.end() && asset_clause_index.count(it->second)) {
+            asset_ids.push_back(it->second);
+        }
+    }
+    
+    // Backbone restricted to the domain: one model plus one assumption call per surviving candidate
+    std::vector<int> backbone;
+    if (!computeBackbone(current_clauses, asset_ids, backbone)) {
+        reportError("domain() operation failed - the current block has no models");
+        std::cout << "Domain check UNSATISFIABLE: the current block has no models" << std::endl;
+        return false;
+    }
+    std::set<int> forced_true;
+    std::set<int> forced_false;
+    for (int lit : backbone) {
+        (lit > 0 ? forced_true : forced_false).insert(std::abs(lit));
+    }
+    
+    std::string forced;
+    std::string free_assets;
+    std::string unreachable;
+    for (const auto& asset_name : domain_assets) {
+        auto it = asset_to_id.find(asset_name);
+        int asset_id = it != asset_to_id.end() ? it->second : 0;
+        std::string& list = forced_true.count(asset_id) ? forced : forced_false.count(asset_id) ? unreachable : free_assets;
+        if (!list.empty()) list += ", ";
+        list += asset_name;
     }
     
-    // For now, all domain() operations are valid
-    // TODO: Implement domain analysis functionality
+    reportWarning("domain() operation completed for " + std::to_string(domain_assets.size()) + " assets");
+    std::cout << "Domain check: forced {" << forced << "}, free {" << free_assets << "}, unreachable {"
+              << unreachable << "}" << std::endl;
     return true;
 }
 
-// Type inference helpers
-
-std::pair<std::string, std::string> SemanticAnalyzer::inferActionType(const std::string& action_string) {
-    // Convert to lowercase for pattern matching
-    std::string lower_action = action_string;
-    std::transform(lower_action.begin(), lower_action.end(), lower_action.begin(), ::tolower);
-    
-    // Define common action patterns and their inferred types
-    // Format: {pattern, {type, constraint}}
-    
-    // Positive service actions (payment, provision, delivery)
-    std::vector<std::string> positive_service_patterns = {
-        "pay", "charge", "bill", "invoice", "compensate", "remunerate", "salary", "wage",
-        "provide", "supply", "deliver", "give", "offer", "grant", "award", "bestow",
-        "serve", "assist", "help", "support", "maintain", "care", "tend", "feed",
-        "repair", "fix", "restore", "renovate", "improve", "enhance", "upgrade",
-        "teach", "train", "educate", "inform", "advise", "counsel", "guide", "direct"
-    };
+bool SemanticAnalyzer::validateEntailsOperation(FunctionCallExpression* func_call) {
+    if (!func_call || !func_call->arguments) {
+        reportError("entails() operation requires an argument list");
+        return false;
+    }
     
-    // Negative service actions (restrictions, obligations, prohibitions)
-    std::vector<std::string> negative_service_patterns = {
-        "forbid", "prohibit", "ban", "restrict", "limit", "constrain", "confine",
-        "abstain", "refrain", "avoid", "prevent", "stop", "cease", "desist",
-        "obligation", "duty", "requirement", "compulsion", "mandate", "impose",
-        "burden", "encumber", "bind", "tie", "commit", "pledge", "vow",
-        "silence", "secrecy", "confidentiality", "nondisclosure", "privacy"
-    };
+    // entails() takes exactly one formula
+    if (func_call->arguments->expressions.size() != 1 || !func_call->arguments->expressions[0]) {
+        reportError("entails() operation requires exactly 1 argument, got " + 
+                   std::to_string(func_call->arguments->expressions.size()));
+        return false;
+    }
+    Expression* formula = func_call->arguments->expressions[0].get();
+    std::string undefined = findUndefinedAsset(formula);
+    if (!undefined.empty()) {
+        reportError("entails() operation requires defined asset arguments (got '" + undefined + "')");
+        return false;
+    }
     
-    // Movable object actions (transfer, possession, handling)
-    std::vector<std::string> movable_object_patterns = {
-        "transfer", "convey", "transport", "move", "shift", "carry", "bear",
-        "sell", "buy", "purchase", "acquire", "obtain", "get", "receive",
-        "exchange", "trade", "swap", "barter", "negotiate", "deal",
-        "lend", "loan", "borrow", "rent", "lease", "hire", "charter",
-        "deliver", "ship", "send", "mail", "post", "dispatch", "forward",
-        "hand", "pass", "transmit", "relay", "convey", "communicate"
-    };
+    if (current_clauses.empty() || collectBlocksOnly) {
+        reportWarning("entails() operation skipped - no clauses in the current block");
+        return true;
+    }
     
-    // Non-movable object actions (real estate, property, location)
-    std::vector<std::string> non_movable_object_patterns = {
-        "own", "possess", "hold", "have", "control", "command", "dominate",
-        "occupy", "inhabit", "dwell", "reside", "live", "stay", "remain",
-        "build", "construct", "erect", "establish", "found", "create",
-        "demolish", "destroy", "tear", "raze", "level", "flatten",
-        "register", "record", "inscribe", "enroll", "list", "catalog",
-        "mortgage", "lien", "encumber", "secure", "guarantee", "pledge"
-    };
+    // Defined assets of the formula that the block never mentions become free variables
+    std::set<int> asset_ids;
+    for (const auto& clause : current_clauses) {
+        collectAssetIDs(clause.expr, asset_ids);
+    }
+    collectAssetIDs(formula, asset_ids);
     
-    // Check each pattern category
-    for (const auto& pattern : positive_service_patterns) {
-        if (lower_action.find(pattern) != std::string::npos) {
-            return {"service", "positive"};
-        }
+    // The block entails the formula iff the block and the formula's negation are unsatisfiable
+    SatSolver solver;
+    CnfEncoder encoder(solver, asset_to_id);
+    for (const auto& clause : current_clauses) {
+        encoder.addConstraint(clause.expr);
     }
+    int formula_lit = encoder.encode(formula);
+    SatSolver::Result status = solver.solve({-formula_lit});
     
-    for (const auto& pattern : negative_service_patterns) {
-        if (lower_action.find(pattern) != std::string::npos) {
-            return {"service", "negative"};
-        }
+    if (status == SatSolver::Result::Unsatisfiable) {
+        bool vacuous = !solver.okay() || solver.solve() == SatSolver::Result::Unsatisfiable;
+        reportWarning("entails() operation successful - the block implies the formula");
+        std::cout << "Entails check HOLDS" << (vacuous ? " (vacuously: the block is unsatisfiable)" : "") << std::endl;
+        return true;
     }
     
-    for (const auto& pattern : movable_object_patterns) {
-        if (lower_action.find(pattern) != std::string::npos) {
-            return {"object", "movable"};
-        }
+    // Print the counterexample: a model of the block falsifying the formula
+    std::unordered_map<int, std::string> id_to_asset;
+    for (const auto& pair : asset_to_id) {
+        id_to_asset[pair.second] = pair.first;
+    }
+    std::string counterexample;
+    for (int asset_id : asset_ids) {
+        if (!counterexample.empty()) counterexample += ", ";
+        counterexample += id_to_asset[asset_id] + " = " + (solver.modelValue(asset_id) ? "true" : "false");
+    }
+    reportWarning("entails() operation: the block does not imply the formula");
+    std::cout << "Entails check FAILS: counterexample " << counterexample << std::endl;
+    return true;
+}
+
+bool SemanticAnalyzer::validatePartyOperation(FunctionCallExpression* func_call) {
+    if (!func_call || !func_call->arguments) {
+        reportError("party() operation requires an argument list");
+        return false;
     }
     
-    for (const auto& pattern : non_movable_object_patterns) {
-        if (lower_action.find(pattern) != std::string::npos) {
-            return {"object", "non_movable"};
-        }
+    // party() takes exactly one subject
+    auto identifier = func_call->arguments->expressions.size() == 1 ?
+                      dynamic_cast<Identifier*>(func_call->arguments->expressions[0].get()) : nullptr;
+    if (!identifier) {
+        reportError("party() operation requires exactly 1 subject argument, got " +
+                   std::to_string(func_call->arguments->expressions.size()) + " arguments");
+        return false;
+    }
+    TypeInfo* party_info = lookupType(identifier->name);
+    if (!party_info || (party_info->type_keyword != "subject" && party_info->type_keyword != "authority")) {
+        reportError("party() operation requires a defined subject or authority (got '" + identifier->name + "')");
+        return false;
     }
     
-    // Default inference: actions involving money/payment typically relate to services
-    if (lower_action.find("price") != std::string::npos || 
-        lower_action.find("cost") != std::string::npos ||
-        lower_action.find("fee") != std::string::npos ||
-        lower_action.find("tax") != std::string::npos ||
-        lower_action.find("interest") != std::string::npos) {
-        return {"service", "positive"};
+    if (current_clauses.empty() || collectBlocksOnly) {
+        reportWarning("party() operation skipped - no clauses in the current block");
+        return true;
     }
     
-    // Default inference: assume movable object for unknown actions
-    // This is a reasonable default since most actions involve transferable items
-    return {"object", "movable"};
+    // Projecting onto the party's assets up front only enumerates their cone
+    std::vector<std::vector<size_t>> cones;
+    std::vector<std::vector<int>> targets;
+    std::vector<std::vector<std::vector<int>>> models;
+    bool satisfiable = projectTargetSets({partyAssets(identifier->name)}, cones, targets, models);
+    std::cout << describePartyProjection(identifier->name, cones[0].size(), targets[0], models[0], satisfiable);
+    if (!satisfiable) {
+        reportError("party() operation failed - the current block has no models");
+        return false;
+    }
+    reportWarning("party() operation completed: " + std::to_string(models[0].size()) + " configurations for '" +
+                  identifier->name + "'");
+    return true;
+}
+
+// Type inference helpers
+
+std::pair<std::string, std::string> SemanticAnalyzer::inferActionType(const std::string& action_string) {
+    // One automaton pass over the literal, memoized; see ActionDictionary for the keyword categories
+    return action_dictionary.infer(action_string);
 }
 
 void SemanticAnalyzer::createImplicitActionDefinition(const std::string& action_string, const std::string& type, const std::string& constraint) {
@@ -2522,6 +4143,7 @@ void SemanticAnalyzer::createImplicitActionDefinition(const std::string& action_
     // Also create a mapping from the original string to the action name
     // This allows the type checking to work with the original string
     symbol_table[action_string] = TypeInfo("action", "", action_components);
+    longest_action_name = std::max({longest_action_name, action_name.size(), action_string.size()});
 }
 
 void SemanticAnalyzer::printClauseTruthTable(const witness::ClauseInfo& clause) {
@@ -2589,6 +4211,32 @@ void SemanticAnalyzer::collectAssetIDs(Expression* expr, std::set<int>& ids) {
     // Add other expression types as needed (ExpressionList, etc.)
 }
 
+std::string SemanticAnalyzer::findUndefinedAsset(Expression* expr) {
+    if (!expr) return "";
+
+    if (auto identifier = dynamic_cast<Identifier*>(expr)) {
+        TypeInfo* asset_info = lookupType(identifier->name);
+        return asset_info && asset_info->type_keyword == "asset" ? "" : identifier->name;
+    }
+    std::vector<Expression*> operands;
+    if (auto func_call = dynamic_cast<FunctionCallExpression*>(expr)) {
+        if (func_call->arguments) {
+            for (const auto& arg : func_call->arguments->expressions) {
+                operands.push_back(arg.get());
+            }
+        }
+    } else if (auto binary_op = dynamic_cast<BinaryOpExpression*>(expr)) {
+        operands = {binary_op->left.get(), binary_op->right.get()};
+    } else if (auto unary_op = dynamic_cast<UnaryOpExpression*>(expr)) {
+        operands = {unary_op->operand.get()};
+    }
+    for (Expression* operand : operands) {
+        std::string undefined = findUndefinedAsset(operand);
+        if (!undefined.empty()) return undefined;
+    }
+    return "";
+}
+
 bool SemanticAnalyzer::evalExpr(Expression* expr, const std::map<int, bool>& assignment) {
     if (!expr) return false;
     
@@ -2664,22 +4312,95 @@ void SemanticAnalyzer::generateExternalSolverTruthTable() {
         return;
     }
 
+    std::string json_filename;
+    std::string result_filename;
+    if (!exportExternalSolverInput(current_clauses, json_filename, result_filename)) {
+        return;
+    }
+    
+    // Call CUDA solver with output filename
+    if (verbose) {
+        std::cout << "\n=== CALLING CUDA SOLVER ===" << std::endl;
+    }
+    std::string cuda_command = "./tree_fold_cuda " + json_filename + " " + result_filename;
+    if (verbose) {
+        std::cout << "Executing: " << cuda_command << std::endl;
+    }
+    
+    int result = system(cuda_command.c_str());
+    if (result != 0) {
+        std::cerr << "Error: CUDA solver returned exit code " << result << std::endl;
+        return;
+    }
+    
+    // Read results from CUDA solver
+    if (verbose) {
+        std::cout << "\n=== READING CUDA SOLVER RESULTS ===" << std::endl;
+    }
+    std::ifstream result_file(result_filename, std::ios::binary);
+    if (!result_file.is_open()) {
+        std::cerr << "Error: Could not open result file " << result_filename << std::endl;
+        return;
+    }
+    
+    std::vector<std::vector<int>> final_combinations;
+    while (result_file.good()) {
+        int size;
+        result_file.read(reinterpret_cast<char*>(&size), sizeof(int));
+        if (result_file.eof()) break;
+        
+        if (size > 0 && size <= 1000) { // Sanity check
+            std::vector<int> combination(size);
+            result_file.read(reinterpret_cast<char*>(combination.data()), size * sizeof(int));
+            if (result_file.good()) {
+                final_combinations.push_back(combination);
+            }
+        }
+    }
+    result_file.close();
+    
+    if (verbose) {
+        std::cout << "CUDA solver found " << final_combinations.size() << " satisfying combinations" << std::endl;
+        
+        // Display first few results
+        std::cout << "\n=== FIRST 10 SATISFYING COMBINATIONS ===" << std::endl;
+        for (size_t i = 0; i < std::min(final_combinations.size(), size_t(10)); ++i) {
+            std::cout << "Combination " << (i + 1) << ": [";
+            for (size_t j = 0; j < final_combinations[i].size(); ++j) {
+                if (j > 0) std::cout << ", ";
+                std::cout << final_combinations[i][j];
+            }
+            std::cout << "]" << std::endl;
+        }
+        
+        if (final_combinations.size() > 10) {
+            std::cout << "... and " << (final_combinations.size() - 10) << " more combinations" << std::endl;
+        }
+        
+        std::cout << "=== END CUDA SOLVER RESULTS ===" << std::endl;
+    }
+}
+
+bool SemanticAnalyzer::exportExternalSolverInput(ClauseView clauses, std::string& json_filename,
+                                                 std::string& result_filename, bool scratch) {
     // Collect all unique asset IDs from all clauses
     std::set<int> all_asset_ids;
-    for (const auto& clause : current_clauses) {
+    for (const auto& clause : clauses) {
         std::set<int> clause_asset_ids;
         collectAssetIDs(clause.expr, clause_asset_ids);
         all_asset_ids.insert(clause_asset_ids.begin(), clause_asset_ids.end());
     }
     std::vector<int> asset_list(all_asset_ids.begin(), all_asset_ids.end());
+    // A scratch export races other engines, so it prints nothing of its own
+    bool report = verbose && !scratch;
 
-    if (verbose) {
+    if (report) {
         std::cout << "\n=== EXTERNAL SOLVER DEBUG: Clause Sets ===" << std::endl;
     }
     std::vector<std::set<std::vector<int>>> clause_satisfying_assignments;
     
-    for (size_t clause_idx = 0; clause_idx < current_clauses.size(); clause_idx++) {
-        const auto& clause = current_clauses[clause_idx];
+    for (size_t clause_idx = 0; clause_idx < clauses.size(); clause_idx++) {
+        const auto& clause = clauses[clause_idx];
         std::set<int> clause_asset_ids;
         collectAssetIDs(clause.expr, clause_asset_ids);
         
@@ -2704,7 +4425,7 @@ void SemanticAnalyzer::generateExternalSolverTruthTable() {
             }
         }
         
-        if (verbose) {
+        if (report) {
             std::cout << "\nClause " << (clause_idx + 1) << ": '" << clause.name << "'" << std::endl;
             std::cout << "  Expression: " << clause.expression << std::endl;
             std::cout << "  Asset IDs: [";
@@ -2727,7 +4448,7 @@ void SemanticAnalyzer::generateExternalSolverTruthTable() {
         clause_satisfying_assignments.push_back(clause_assignments);
     }
     
-    if (verbose) {
+    if (report) {
         std::cout << "\n=== SOLVER INTERFACE INPUT ===" << std::endl;
         std::cout << "Number of clauses: " << clause_satisfying_assignments.size() << std::endl;
         for (size_t i = 0; i < clause_satisfying_assignments.size(); i++) {
@@ -2737,10 +4458,12 @@ void SemanticAnalyzer::generateExternalSolverTruthTable() {
     }
     
     // Export data for CUDA solver (CudaSet format)
-    exportForCudaSolver(clause_satisfying_assignments, all_asset_ids);
+    if (!scratch) {
+        exportForCudaSolver(clause_satisfying_assignments, all_asset_ids);
+    }
 
     // --- JSON Export and CUDA Solver Execution ---
-    if (verbose) {
+    if (report) {
         std::cout << "\n=== JSON EXPORT FOR CUDA ===" << std::endl;
     }
     std::ostringstream json;
@@ -2783,11 +4506,7 @@ void SemanticAnalyzer::generateExternalSolverTruthTable() {
         }
         
         // Get asset components from symbol table
-        std::vector<std::string> components;
-        auto it = symbol_table.find(asset_name);
-        if (it != symbol_table.end() && it->second.type_keyword == "asset") {
-            components = it->second.asset_components;
-        }
+        std::vector<std::string> components = getAssetComponentsByName(asset_name);
         
         // Get string values for components from symbol table
         std::vector<std::string> component_strings;
@@ -2828,7 +4547,7 @@ void SemanticAnalyzer::generateExternalSolverTruthTable() {
     }
     json << "},\n  \"clauses\": [\n";
     for (size_t clause_idx = 0; clause_idx < clause_satisfying_assignments.size(); ++clause_idx) {
-        const auto& clause = current_clauses[clause_idx];
+        const auto& clause = clauses[clause_idx];
         const auto& assignments = clause_satisfying_assignments[clause_idx];
         // Get the asset list for this clause
         std::set<int> clause_asset_ids;
@@ -2859,49 +4578,73 @@ void SemanticAnalyzer::generateExternalSolverTruthTable() {
     json << "  ]\n}";
     
     // Generate unique filenames for this global check
-    global_check_counter++;
-    std::string json_filename = "witness_export_" + std::to_string(global_check_counter) + ".json";
-    std::string result_filename = "zdd_" + std::to_string(global_check_counter) + ".bin";
+    if (scratch) {
+        std::string stem = (std::filesystem::temp_directory_path() /
+                            ("witness_portfolio_" + std::to_string(getpid()) + "_" + std::to_string(block_counter))).string();
+        json_filename = stem + ".json";
+        result_filename = stem + ".bin";
+    } else {
+        global_check_counter++;
+        json_filename = "witness_export_" + std::to_string(global_check_counter) + ".json";
+        result_filename = "zdd_" + std::to_string(global_check_counter) + ".bin";
+    }
     
     // Write JSON to file
     std::ofstream json_file(json_filename);
     if (json_file.is_open()) {
         json_file << json.str();
         json_file.close();
-        if (verbose) {
+        if (report) {
             std::cout << "JSON exported to " << json_filename << std::endl;
         }
     } else {
         std::cerr << "Error: Could not write JSON to " << json_filename << std::endl;
-        return;
-    }
-    
-    // Call CUDA solver with output filename
-    if (verbose) {
-        std::cout << "\n=== CALLING CUDA SOLVER ===" << std::endl;
-    }
-    std::string cuda_command = "./tree_fold_cuda " + json_filename + " " + result_filename;
-    if (verbose) {
-        std::cout << "Executing: " << cuda_command << std::endl;
+        return false;
     }
-    
-    int result = system(cuda_command.c_str());
-    if (result != 0) {
-        std::cerr << "Error: CUDA solver returned exit code " << result << std::endl;
-        return;
+    return true;
+}
+
+void SemanticAnalyzer::normalizeExternalModels(const std::vector<int>& asset_ids, std::vector<std::vector<int>>& models) {
+    std::unordered_map<int, size_t> position;
+    for (size_t i = 0; i < asset_ids.size(); i++) {
+        position[asset_ids[i]] = i;
+    }
+
+    // A combination fixes some assets; the ones it leaves out take both values
+    std::set<unsigned long long> indices;
+    for (const auto& combination : models) {
+        unsigned long long fixed = 0;
+        unsigned long long value = 0;
+        for (int lit : combination) {
+            auto it = position.find(std::abs(lit));
+            if (it == position.end()) continue;
+            fixed |= 1ULL << it->second;
+            if (lit > 0) value |= 1ULL << it->second;
+        }
+        unsigned long long free_mask = ((1ULL << asset_ids.size()) - 1) & ~fixed;
+        for (unsigned long long subset = free_mask;; subset = (subset - 1) & free_mask) {
+            indices.insert(value | subset);
+            if (subset == 0) break;
+        }
     }
-    
-    // Read results from CUDA solver
-    if (verbose) {
-        std::cout << "\n=== READING CUDA SOLVER RESULTS ===" << std::endl;
+
+    models.clear();
+    for (unsigned long long index : indices) {
+        std::vector<int> assignment;
+        for (size_t i = 0; i < asset_ids.size(); i++) {
+            assignment.push_back((index >> i) & 1 ? asset_ids[i] : -asset_ids[i]);
+        }
+        models.push_back(assignment);
     }
+}
+
+bool SemanticAnalyzer::readExternalSolverResults(const std::string& result_filename, std::vector<std::vector<int>>& assignments) {
     std::ifstream result_file(result_filename, std::ios::binary);
     if (!result_file.is_open()) {
-        std::cerr << "Error: Could not open result file " << result_filename << std::endl;
-        return;
+        return false;
     }
-    
-    std::vector<std::vector<int>> final_combinations;
+
+    // Read combinations from binary file
     while (result_file.good()) {
         int size;
         result_file.read(reinterpret_cast<char*>(&size), sizeof(int));
@@ -2911,32 +4654,11 @@ void SemanticAnalyzer::generateExternalSolverTruthTable() {
             std::vector<int> combination(size);
             result_file.read(reinterpret_cast<char*>(combination.data()), size * sizeof(int));
             if (result_file.good()) {
-                final_combinations.push_back(combination);
-            }
-        }
-    }
-    result_file.close();
-    
-    if (verbose) {
-        std::cout << "CUDA solver found " << final_combinations.size() << " satisfying combinations" << std::endl;
-        
-        // Display first few results
-        std::cout << "\n=== FIRST 10 SATISFYING COMBINATIONS ===" << std::endl;
-        for (size_t i = 0; i < std::min(final_combinations.size(), size_t(10)); ++i) {
-            std::cout << "Combination " << (i + 1) << ": [";
-            for (size_t j = 0; j < final_combinations[i].size(); ++j) {
-                if (j > 0) std::cout << ", ";
-                std::cout << final_combinations[i][j];
+                assignments.push_back(combination);
             }
-            std::cout << "]" << std::endl;
-        }
-        
-        if (final_combinations.size() > 10) {
-            std::cout << "... and " << (final_combinations.size() - 10) << " more combinations" << std::endl;
         }
-        
-        std::cout << "=== END CUDA SOLVER RESULTS ===" << std::endl;
     }
+    return true;
 }
 
 } // namespace witness 
\ No newline at end of file
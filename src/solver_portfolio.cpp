@@ -0,0 +1,116 @@
+#include "solver_portfolio.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace witness {
+
+void SolverPortfolio::addEngine(const std::string& name, Engine engine) {
+    engines.push_back({name, std::move(engine)});
+}
+
+PortfolioOutcome SolverPortfolio::race() {
+    PortfolioOutcome outcome;
+    std::atomic<bool> cancel(false);
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t finished = 0;
+
+    // How each engine actually finished, recorded by its own thread
+    enum class Finish { Won, Failed, Cancelled };
+    std::vector<Finish> finishes(engines.size(), Finish::Cancelled);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < engines.size(); i++) {
+        threads.emplace_back([&, i]() {
+            std::vector<std::vector<int>> assignments;
+            bool definitive = false;
+            try {
+                definitive = engines[i].second(cancel, assignments);
+            } catch (const std::exception&) {
+                definitive = false;
+            }
+            // An engine that gave up before anyone won failed on its own
+            bool stopped_early = cancel;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            finishes[i] = definitive || stopped_early ? Finish::Cancelled : Finish::Failed;
+            if (definitive && outcome.winner.empty()) {
+                finishes[i] = Finish::Won;
+                outcome.winner = engines[i].first;
+                outcome.assignments = std::move(assignments);
+                outcome.elapsed_ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start).count();
+                cancel = true;
+            }
+            finished++;
+            done.notify_one();
+        });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]() { return !outcome.winner.empty() || finished == engines.size(); });
+    }
+    cancel = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < engines.size(); i++) {
+        if (finishes[i] == Finish::Failed) {
+            outcome.failed.push_back(engines[i].first);
+        } else if (finishes[i] == Finish::Cancelled) {
+            outcome.cancelled.push_back(engines[i].first);
+        }
+    }
+    return outcome;
+}
+
+int SolverPortfolio::runCancellable(const std::vector<std::string>& argv, const std::atomic<bool>& cancel) {
+    if (argv.empty()) return -1;
+
+    std::vector<char*> args;
+    for (const auto& arg : argv) {
+        args.push_back(const_cast<char*>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        // A racing engine stays silent; its answer comes back through its files
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            dup2(devnull, STDERR_FILENO);
+            close(devnull);
+        }
+        execv(args[0], args.data());
+        _exit(127);
+    }
+
+    // Poll the child so a winning engine elsewhere can stop it promptly
+    while (true) {
+        int status = 0;
+        pid_t waited = waitpid(pid, &status, WNOHANG);
+        if (waited == pid) {
+            return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        }
+        if (waited < 0) return -1;
+        if (cancel) {
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            return -1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+} // namespace witness
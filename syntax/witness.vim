@@ -12,7 +12,7 @@ syn keyword witnessLogical AND OR NOT IMPLIES EQUIV
 syn keyword witnessType movable non_movable positive negative
 
 " System operations
-syn keyword witnessSystemOp global domain litis meet
+syn keyword witnessSystemOp global domain litis meet entails
 
 " Join operations  
 syn keyword witnessJoinOp join sell compensation consideration forbearance encumber access lien evidence argument